@@ -0,0 +1,96 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Benchmarks of `get_conn_padded` for the most common operators."""
+
+import numpy as np
+
+import jax
+
+import netket as nk
+
+from harness import benchmark
+
+SIZES = [16, 64, 256]
+QUICK_SIZES = [16]
+BATCH = 1024
+
+
+def _spin_operators(kind: str, N: int):
+    g = nk.graph.Chain(N, pbc=True)
+    hi = nk.hilbert.Spin(0.5, N)
+    if kind == "ising":
+        op = nk.operator.Ising(hi, g, h=1.0)
+    elif kind == "local":
+        # Heisenberg model stored as a generic LocalOperator
+        op = nk.operator.LocalOperator(hi, dtype=float)
+        for i, j in g.edges():
+            op += nk.operator.spin.sigmax(hi, i) @ nk.operator.spin.sigmax(hi, j)
+            op += nk.operator.spin.sigmay(hi, i) @ nk.operator.spin.sigmay(hi, j)
+            op += nk.operator.spin.sigmaz(hi, i) @ nk.operator.spin.sigmaz(hi, j)
+    elif kind == "pauli":
+        strings, weights = [], []
+        for i, j in g.edges():
+            for p in "XYZ":
+                s = ["I"] * N
+                s[i], s[j] = p, p
+                strings.append("".join(s))
+                weights.append(1.0)
+        op = nk.operator.PauliStrings(hi, strings, weights)
+    else:
+        raise ValueError(kind)
+    return hi, op
+
+
+def _fermion_operator(N: int):
+    # spinless hopping with nearest-neighbour density interaction on a ring
+    hi = nk.hilbert.SpinOrbitalFermions(N, n_fermions=N // 2)
+    terms, weights = [], []
+    for i in range(N):
+        j = (i + 1) % N
+        terms += [f"{i}^ {j}", f"{j}^ {i}", f"{i}^ {i} {j}^ {j}"]
+        weights += [-1.0, -1.0, 0.5]
+    return hi, nk.operator.FermionOperator2nd(hi, terms, weights)
+
+
+def _get_conn_padded_bench(hi, op, backend):
+    x = hi.random_state(jax.random.PRNGKey(0), BATCH)
+    if backend == "numba":
+        x = np.asarray(x)
+        return lambda: op.get_conn_padded(x)
+    else:
+        op = op.to_jax_operator()
+        fun = jax.jit(lambda op, x: op.get_conn_padded(x))
+        return lambda: fun(op, x)
+
+
+@benchmark(
+    "operator.get_conn_padded",
+    params={
+        "operator": ["ising", "local", "pauli", "fermion"],
+        "backend": ["numba", "jax"],
+        "N": SIZES,
+    },
+    quick_params={
+        "operator": ["ising", "local", "pauli", "fermion"],
+        "backend": ["numba", "jax"],
+        "N": QUICK_SIZES,
+    },
+)
+def get_conn_padded(operator, backend, N):
+    if operator == "fermion":
+        hi, op = _fermion_operator(N)
+    else:
+        hi, op = _spin_operators(operator, N)
+    return _get_conn_padded_bench(hi, op, backend)
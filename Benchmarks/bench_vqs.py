@@ -0,0 +1,134 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Benchmarks of sampling, of the estimation of expectation values and gradients,
+of the solution of the QGT linear system and of a TDVP time step.
+"""
+
+import jax
+import jax.numpy as jnp
+
+import netket as nk
+import netket.experimental as nkx
+
+from harness import benchmark
+
+N_SAMPLES = 1024
+SIZES = [16, 64, 256]
+QUICK_SIZES = [16]
+
+
+def _setup_vstate(N, chunk_size=None, *, alpha=1, n_samples=N_SAMPLES):
+    g = nk.graph.Chain(N, pbc=True)
+    hi = nk.hilbert.Spin(0.5, N)
+    ha = nk.operator.IsingJax(hi, g, h=1.0)
+    sa = nk.sampler.MetropolisLocal(hi, n_chains=16)
+    vs = nk.vqs.MCState(
+        sa,
+        nk.models.RBM(alpha=alpha, param_dtype=complex),
+        n_samples=n_samples,
+        n_discard_per_chain=0,
+        chunk_size=chunk_size,
+        seed=0,
+        sampler_seed=1,
+    )
+    return ha, vs
+
+
+@benchmark(
+    "sampler.MetropolisLocal.sample",
+    params={"N": SIZES, "n_chains": [16, 256], "sweep_size": [None]},
+    quick_params={"N": QUICK_SIZES, "n_chains": [16], "sweep_size": [None]},
+)
+def metropolis_sample(N, n_chains, sweep_size):
+    hi = nk.hilbert.Spin(0.5, N)
+    sa = nk.sampler.MetropolisLocal(hi, n_chains=n_chains, sweep_size=sweep_size)
+    model = nk.models.RBM(alpha=1, param_dtype=complex)
+    pars = model.init(jax.random.PRNGKey(0), jnp.zeros((1, N)))
+    state = sa.init_state(model, pars, seed=0)
+    state = sa.reset(model, pars, state)
+    chain_length = max(N_SAMPLES // sa.n_chains, 1)
+
+    def run():
+        samples, _ = sa.sample(model, pars, state=state, chain_length=chain_length)
+        return samples
+
+    return run
+
+
+@benchmark(
+    "vqs.MCState.expect_and_grad",
+    params={"N": SIZES, "chunk_size": [None, 256]},
+    quick_params={"N": QUICK_SIZES, "chunk_size": [None, 256]},
+)
+def expect_and_grad(N, chunk_size):
+    ha, vs = _setup_vstate(N, chunk_size)
+    vs.samples  # sample once, we only want to time the estimator
+
+    return lambda: vs.expect_and_grad(ha)
+
+
+@benchmark(
+    "optimizer.qgt.solve",
+    params={
+        "qgt": ["QGTOnTheFly", "QGTJacobianDense"],
+        "N": SIZES,
+        "chunk_size": [None, 256],
+    },
+    quick_params={
+        "qgt": ["QGTOnTheFly", "QGTJacobianDense"],
+        "N": QUICK_SIZES,
+        "chunk_size": [None],
+    },
+)
+def qgt_solve(qgt, N, chunk_size):
+    ha, vs = _setup_vstate(N, chunk_size)
+    _, grad = vs.expect_and_grad(ha)
+    qgt_type = getattr(nk.optimizer.qgt, qgt)
+
+    if qgt == "QGTOnTheFly":
+        solver = jax.scipy.sparse.linalg.cg
+    else:
+        solver = nk.optimizer.solver.cholesky
+
+    def run():
+        # include the construction of the QGT, as done at every step of a driver
+        S = qgt_type(vs, diag_shift=0.01)
+        x, _ = S.solve(solver, grad)
+        return x
+
+    return run
+
+
+@benchmark(
+    "driver.TDVP.step",
+    params={"N": SIZES, "chunk_size": [None]},
+    quick_params={"N": QUICK_SIZES, "chunk_size": [None]},
+)
+def tdvp_step(N, chunk_size):
+    ha, vs = _setup_vstate(N, chunk_size, n_samples=512)
+    dt = 0.001
+    te = nkx.TDVP(
+        ha,
+        vs,
+        nkx.dynamics.Euler(dt),
+        qgt=nk.optimizer.qgt.QGTJacobianDense(holomorphic=True, diag_shift=1e-4),
+    )
+
+    def run():
+        te.advance(dt)
+        return vs.parameters
+
+    return run
@@ -0,0 +1,177 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Minimal benchmark harness used by the scripts in this directory.
+
+A benchmark is a function decorated with :func:`benchmark`, which receives the
+parameters of one point of the sweep as keyword arguments and returns a
+zero-argument callable executing the operation to be timed.
+The harness times the first call separately (which includes tracing, XLA and
+Numba compilation) from the following calls (the steady-state time), and
+collects the results in a JSON-serializable list of dictionaries.
+"""
+
+import gc
+import itertools
+import platform
+import re
+import time
+import traceback
+from collections.abc import Callable
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+
+import numpy as np
+
+import jax
+
+_REGISTRY: dict[str, "Benchmark"] = {}
+
+
+@dataclass
+class Benchmark:
+    name: str
+    """Unique name of the benchmark, in the form `group.operation`."""
+    setup: Callable[..., Callable[[], object]]
+    """Function taking the parameters and returning the callable to time."""
+    params: dict[str, list] = field(default_factory=dict)
+    """Parameter grid swept by the benchmark."""
+    quick_params: dict[str, list] | None = None
+    """Reduced parameter grid used with `--quick`."""
+
+    def grid(self, quick: bool = False):
+        params = self.quick_params if quick and self.quick_params else self.params
+        keys = list(params.keys())
+        for values in itertools.product(*(params[k] for k in keys)):
+            yield dict(zip(keys, values))
+
+
+def benchmark(name: str, *, params: dict[str, list], quick_params=None):
+    """
+    Registers a benchmark.
+
+    Args:
+        name: Unique name of the benchmark.
+        params: Dictionary mapping every parameter name to the list of values
+            to sweep. The benchmark is run on the cartesian product of all lists.
+        quick_params: Optional reduced grid used when running with `--quick`.
+    """
+
+    def decorator(setup):
+        if name in _REGISTRY:
+            raise ValueError(f"Benchmark {name} is already registered.")
+        _REGISTRY[name] = Benchmark(name, setup, params, quick_params)
+        return setup
+
+    return decorator
+
+
+def registered_benchmarks(pattern: str | None = None) -> list[Benchmark]:
+    """Returns the registered benchmarks whose name matches the regex `pattern`."""
+    return [
+        b for n, b in _REGISTRY.items() if pattern is None or re.search(pattern, n)
+    ]
+
+
+def block(x):
+    """Waits for all jax arrays in the pytree `x` to be computed."""
+    return jax.block_until_ready(x)
+
+
+def time_callable(fun: Callable[[], object], *, n_repeat: int, min_time: float):
+    """
+    Times `fun`, returning the time of the first (compiling) call and the
+    steady-state times of the following calls.
+
+    At least `n_repeat` steady-state calls are performed, and more are added until
+    their total time exceeds `min_time` seconds.
+    """
+    gc.collect()
+    t0 = time.perf_counter()
+    block(fun())
+    first_call = time.perf_counter() - t0
+
+    times = []
+    while len(times) < n_repeat or sum(times) < min_time:
+        t0 = time.perf_counter()
+        block(fun())
+        times.append(time.perf_counter() - t0)
+        # never run for more than 1000 iterations
+        if len(times) >= 1000:
+            break
+
+    times = np.asarray(times)
+    return {
+        "first_call": first_call,
+        # estimate of the time spent compiling, excluding the execution
+        "compile_time": max(first_call - float(np.median(times)), 0.0),
+        "n_repeat": int(times.size),
+        "mean": float(times.mean()),
+        "median": float(np.median(times)),
+        "min": float(times.min()),
+        "std": float(times.std()),
+    }
+
+
+def run_benchmark(
+    bench: Benchmark, *, quick: bool, n_repeat: int, min_time: float, verbose=True
+):
+    """Runs all points of the parameter grid of a benchmark."""
+    results = []
+    for params in bench.grid(quick):
+        entry = {"name": bench.name, "params": params}
+        fun = None
+        try:
+            t0 = time.perf_counter()
+            fun = bench.setup(**params)
+            entry["setup_time"] = time.perf_counter() - t0
+            entry.update(time_callable(fun, n_repeat=n_repeat, min_time=min_time))
+            status = f"{entry['median'] * 1e3:10.3f} ms  (compile {entry['compile_time']:.2f} s)"
+        except Exception as err:  # noqa: BLE001
+            entry["error"] = f"{type(err).__name__}: {err}"
+            entry["traceback"] = traceback.format_exc()
+            status = f"FAILED: {entry['error']}"
+        if verbose:
+            print(f"{bench.name:40s} {_format_params(params):40s} {status}", flush=True)
+        results.append(entry)
+        # free device buffers held by the closures before the next point
+        del fun
+        jax.clear_caches()
+    return results
+
+
+def environment_info() -> dict:
+    """Information on the software and hardware the benchmarks were run on."""
+    import netket as nk
+    import numba
+
+    return {
+        "timestamp": datetime.now(timezone.utc).isoformat(),
+        "netket": nk.__version__,
+        "jax": jax.__version__,
+        "numba": numba.__version__,
+        "numpy": np.__version__,
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "backend": jax.default_backend(),
+        "devices": [str(d) for d in jax.devices()],
+        "x64": bool(jax.config.jax_enable_x64),
+        "mpi_nodes": nk.utils.mpi.n_nodes,
+        "sharding": bool(nk.config.netket_experimental_sharding),
+    }
+
+
+def _format_params(params):
+    return ", ".join(f"{k}={v}" for k, v in params.items())
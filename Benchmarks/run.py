@@ -0,0 +1,117 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Runs the NetKet benchmark suite and writes the results to a JSON file.
+
+Usage examples:
+
+.. code-block:: bash
+
+    # run everything and save to results.json
+    python Benchmarks/run.py -o results.json
+
+    # only the operator benchmarks, on the reduced grid
+    python Benchmarks/run.py --filter operator --quick
+
+    # compare two result files
+    python Benchmarks/run.py --compare old.json new.json
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent))
+
+import harness  # noqa: E402
+
+# Importing the modules registers the benchmarks
+import bench_operators  # noqa: E402, F401
+import bench_vqs  # noqa: E402, F401
+
+
+def _key(entry):
+    return (entry["name"], json.dumps(entry["params"], sort_keys=True))
+
+
+def compare(old_file, new_file, threshold):
+    """Prints the ratio of the steady-state times of two result files."""
+    old = {_key(e): e for e in json.loads(Path(old_file).read_text())["results"]}
+    new = {_key(e): e for e in json.loads(Path(new_file).read_text())["results"]}
+
+    n_regressions = 0
+    for key, entry in new.items():
+        if key not in old or "error" in entry or "error" in old[key]:
+            continue
+        ratio = entry["median"] / old[key]["median"]
+        compile_ratio = (entry["compile_time"] + 1e-9) / (
+            old[key]["compile_time"] + 1e-9
+        )
+        flag = ""
+        if ratio > 1 + threshold:
+            flag = "  <-- REGRESSION"
+            n_regressions += 1
+        print(
+            f"{key[0]:40s} {key[1]:50s} runtime x{ratio:5.2f}  compile x{compile_ratio:5.2f}{flag}"
+        )
+    return n_regressions
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("-o", "--output", type=str, default=None)
+    parser.add_argument("--filter", type=str, default=None, help="regex on names")
+    parser.add_argument("--quick", action="store_true", help="use the reduced grid")
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument(
+        "--min-time", type=float, default=0.5, help="minimum steady-state time [s]"
+    )
+    parser.add_argument("--list", action="store_true", help="list the benchmarks")
+    parser.add_argument("--compare", nargs=2, metavar=("OLD", "NEW"))
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="relative slowdown flagged as regression by --compare",
+    )
+    args = parser.parse_args(argv)
+
+    if args.compare is not None:
+        n_regressions = compare(*args.compare, args.threshold)
+        return 1 if n_regressions > 0 else 0
+
+    benchmarks = harness.registered_benchmarks(args.filter)
+    if args.list:
+        for b in benchmarks:
+            print(f"{b.name:40s} {b.params}")
+        return 0
+
+    results = []
+    for b in benchmarks:
+        results += harness.run_benchmark(
+            b, quick=args.quick, n_repeat=args.repeat, min_time=args.min_time
+        )
+
+    output = {"environment": harness.environment_info(), "results": results}
+    if args.output is not None:
+        Path(args.output).write_text(json.dumps(output, indent=2))
+    else:
+        print(json.dumps(output, indent=2))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
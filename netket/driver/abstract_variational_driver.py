@@ -17,6 +17,8 @@ from collections.abc import Callable, Iterable
 
 import abc
 import numbers
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
 from functools import partial
 
 from tqdm.auto import tqdm
@@ -47,6 +49,65 @@ def _to_iterable(maybe_iterable: T | Iterable[T]) -> tuple[T, ...]:
     return tuple(maybe_iterable)
 
 
+class _LoggingWorker:
+    """
+    Executes the logging of every step in a single background thread, in order.
+
+    At most `max_pending` steps are queued at any time: when the queue is full,
+    the driver waits for the oldest step to be logged. Exceptions raised while
+    logging are re-raised in the main thread.
+    """
+
+    def __init__(self, max_pending: int = 2):
+        self._executor = ThreadPoolExecutor(
+            max_workers=1, thread_name_prefix="netket-logging"
+        )
+        self._pending = deque()
+        self._max_pending = max_pending
+
+    def submit(self, fun, *args):
+        # re-raise errors of completed steps as soon as possible
+        while len(self._pending) > 0 and self._pending[0].done():
+            self._pending.popleft().result()
+        while len(self._pending) >= self._max_pending:
+            self._pending.popleft().result()
+        self._pending.append(self._executor.submit(fun, *args))
+
+    def close(self, raise_errors: bool = True):
+        """
+        Waits for all the pending steps to be logged. If `raise_errors=False`,
+        the errors raised while logging are discarded, which is used when the
+        driver is already propagating another exception.
+        """
+        try:
+            while len(self._pending) > 0:
+                try:
+                    self._pending.popleft().result()
+                except Exception:
+                    if raise_errors:
+                        raise
+        finally:
+            self._executor.shutdown(wait=True)
+
+
+class _StateSnapshot:
+    """
+    Copy, on the host, of the variables of a variational state at a given step,
+    passed to the loggers instead of the state when logging asynchronously.
+    """
+
+    def __init__(self, variables: PyTree):
+        self.variables = variables
+
+    @property
+    def parameters(self) -> PyTree:
+        return self.variables["params"]
+
+    @property
+    def model_state(self) -> PyTree:
+        return {k: v for k, v in self.variables.items() if k != "params"}
+
+
 class AbstractVariationalDriver(abc.ABC):
     """Abstract base class for NetKet Variational Monte Carlo drivers
 
@@ -258,6 +319,7 @@ class AbstractVariationalDriver(abc.ABC):
         write_every: int = 50,  # for default logger
         callback: CallbackT | Iterable[CallbackT] = lambda *x: True,
         timeit: bool = False,
+        async_logging: bool = False,
     ):
         """
         Runs this variational driver, updating the weights of the network stored in
@@ -302,6 +364,23 @@ class AbstractVariationalDriver(abc.ABC):
             The change was required to work correctly and efficiently with sharding. It will
             only affect users that were defining custom loggers themselves.
 
+        If `async_logging=True`, the loggers and the progress bar are executed in a
+        background thread, so that the computation of the next steps is dispatched
+        to the device without waiting for the logged data to be written. The data
+        of every step is copied to the host by the main thread only after the next
+        step has been dispatched, so that the transfer overlaps with its
+        computation. The loggers only receive host data: the `log_data` dictionary
+        and, instead of the variational state, an object exposing its
+        `variables`, `parameters` and `model_state` at that step as numpy arrays.
+
+        .. note::
+
+            Only the loggers and the progress bar are moved to the background
+            thread. Callbacks are still executed synchronously at every step,
+            because they can modify the logged data and stop the optimisation,
+            so expensive callbacks (for example, those transferring data to the
+            host) keep blocking the loop.
+
         Args:
             n_iter: the total number of iterations to be performed during this run.
             out: A logger object, or an iterable of loggers, to be used to store simulation log and data.
@@ -315,6 +394,10 @@ class AbstractVariationalDriver(abc.ABC):
             write_every: Every how many steps the json data should be flushed to disk (ignored if
                 logger is provided)
             timeit: If True, provide timing information.
+            async_logging: If True, execute the loggers in a background thread
+                (default=False), passing them a host copy of the variables instead of
+                the variational state. Callbacks are still executed synchronously.
+                Not supported when running on multiple processes.
         """
 
         if not isinstance(n_iter, numbers.Number):
@@ -322,6 +405,12 @@ class AbstractVariationalDriver(abc.ABC):
                 "n_iter, the first positional argument to `run`, must be a number!"
             )
 
+        if async_logging and (mpi.n_nodes > 1 or jax.process_count() > 1):
+            raise ValueError(
+                "async_logging=True is not supported when running on multiple "
+                "processes, because loggers might need to communicate among them."
+            )
+
         if obs is None:
             obs = {}
 
@@ -334,6 +423,30 @@ class AbstractVariationalDriver(abc.ABC):
         loggers = _to_iterable(out)
         callbacks = _to_iterable(callback)
         callback_stop = False
+        logging_worker = _LoggingWorker() if async_logging else None
+        # data of the last step, still on the device, to be logged asynchronously
+        pending_log = None
+
+        def _log_step(step_count, log_data, state, loss_stats, pbar):
+            # if the cost-function is defined then report it in the progress bar
+            if loss_stats is not None:
+                pbar.set_postfix_str(self._loss_name + "=" + str(loss_stats))
+
+            for logger in loggers:
+                logger(step_count, log_data, state)
+
+        def _submit_pending_log(pbar):
+            # the arrays are immutable, so they can be copied to the host after
+            # the driver has moved on to the next step
+            step_count, log_data, variables, loss_stats = jax.device_get(pending_log)
+            logging_worker.submit(
+                _log_step,
+                step_count,
+                log_data,
+                _StateSnapshot(variables),
+                loss_stats,
+                pbar,
+            )
 
         with timing.timed_scope(force=timeit) as timer:
             with tqdm(
@@ -344,38 +457,64 @@ class AbstractVariationalDriver(abc.ABC):
                 old_step = self.step_count
                 first_step = True
 
-                for step in self.iter(n_iter, step_size):
-                    log_data = self.estimate(obs)
-                    self._log_additional_data(log_data, step)
-
-                    # if the cost-function is defined then report it in the progress bar
-                    if self._loss_stats is not None:
-                        pbar.set_postfix_str(
-                            self._loss_name + "=" + str(self._loss_stats)
-                        )
-                        log_data[self._loss_name] = self._loss_stats
-
-                    # Execute callbacks before loggers because they can append to log_data
-                    for callback in callbacks:
-                        if not callback(step, log_data, self):
-                            callback_stop = True
-
-                    with timing.timed_scope(name="loggers"):
-                        for logger in loggers:
-                            logger(self.step_count, log_data, self.state)
-
-                    if len(callbacks) > 0:
-                        if mpi.mpi_any(callback_stop):
-                            break
-
-                    # Reset the timing of tqdm after the first step, to ignore compilation time
-                    if first_step:
-                        first_step = False
-                        pbar.unpause()
-
-                    # Update the progress bar
-                    pbar.update(self.step_count - old_step)
-                    old_step = self.step_count
+                try:
+                    for step in self.iter(n_iter, step_size):
+                        log_data = self.estimate(obs)
+                        self._log_additional_data(log_data, step)
+
+                        if self._loss_stats is not None:
+                            log_data[self._loss_name] = self._loss_stats
+
+                        # Execute callbacks before loggers because they can append to log_data
+                        for callback in callbacks:
+                            if not callback(step, log_data, self):
+                                callback_stop = True
+
+                        with timing.timed_scope(name="loggers"):
+                            if logging_worker is None:
+                                _log_step(
+                                    self.step_count,
+                                    log_data,
+                                    self.state,
+                                    self._loss_stats,
+                                    pbar,
+                                )
+                            else:
+                                if pending_log is not None:
+                                    _submit_pending_log(pbar)
+                                pending_log = (
+                                    self.step_count,
+                                    log_data,
+                                    self.state.variables,
+                                    self._loss_stats,
+                                )
+
+                        if len(callbacks) > 0:
+                            if mpi.mpi_any(callback_stop):
+                                break
+
+                        # Reset the timing of tqdm after the first step, to ignore compilation time
+                        if first_step:
+                            first_step = False
+                            pbar.unpause()
+
+                        # Update the progress bar
+                        pbar.update(self.step_count - old_step)
+                        old_step = self.step_count
+                except BaseException:
+                    # an error raised while logging the previous steps must not
+                    # replace the one raised by the optimisation loop
+                    if logging_worker is not None:
+                        logging_worker.close(raise_errors=False)
+                    raise
+                else:
+                    # wait for all the steps to be logged
+                    if logging_worker is not None:
+                        try:
+                            if pending_log is not None:
+                                _submit_pending_log(pbar)
+                        finally:
+                            logging_worker.close()
 
                 # Final update so that it shows up filled.
                 pbar.update(self.step_count - old_step)
@@ -13,25 +13,156 @@
 # limitations under the License.
 
 
+from concurrent.futures import ThreadPoolExecutor as _ThreadPoolExecutor
+from functools import partial as _partial
+
 import numpy as _np
+from scipy.sparse import csr_matrix as _csr_matrix
 from scipy.sparse.linalg import bicgstab as _bicgstab
 from scipy.sparse.linalg import LinearOperator as _LinearOperator
 
+import jax as _jax
+import jax.numpy as _jnp
+
 from .operator import AbstractOperator as _AbstractOperator
+from .operator import DiscreteJaxOperator as _DiscreteJaxOperator
+from .utils.numba_threads import numba_num_threads as _numba_num_threads
 from jax.experimental.sparse import JAXSparse as _JAXSparse
 
 
+@_partial(_jax.jit, static_argnums=0)
+def _matvec_rows_jax(hilbert, operator, numbers, v):
+    # rows `numbers` of operator @ v
+    x = hilbert.numbers_to_states(numbers)
+    xp, mels = operator.get_conn_padded(x)
+    # padding elements have zero matrix element and a valid state
+    return _jnp.sum(mels * v[hilbert.states_to_numbers(xp)], axis=-1)
+
+
+@_jax.jit
+def _sector_matvec_rows_jax(index, operator, numbers, v):
+    # rows `numbers` of operator @ v in the basis of a symmetry sector
+    x = index.numbers_to_states(numbers)
+    xp, mels = operator.get_conn_padded(x)
+    columns, phases, valid = index.canonicalize(xp)
+    values = mels * phases * index.norms[columns] / index.norms[numbers][:, None]
+    return _jnp.sum(_jnp.where(valid, values * v[columns], 0), axis=-1)
+
+
+def _matvec_rows_numba(operator, numbers, v, index=None):
+    # rows `numbers` of operator @ v, built as a csr matrix with only those rows
+    if index is None:
+        x = _np.asarray(operator.hilbert.numbers_to_states(numbers))
+    else:
+        x = _np.asarray(index.numbers_to_states(numbers))
+
+    sections = _np.empty(x.shape[0] + 1, dtype=_np.int32)
+    sections[0] = 0
+    x_prime, mels = operator.get_conn_flattened(x, sections[1:])
+    if index is None:
+        columns = _np.asarray(operator.hilbert.states_to_numbers(x_prime))
+    else:
+        rows = _np.repeat(numbers, _np.diff(sections))
+        columns, mels = index.sector_matrix_elements(rows, x_prime, mels)
+
+    rows = _csr_matrix((mels, columns, sections), shape=(x.shape[0], v.shape[0]))
+    return rows @ v
+
+
+def _fill_chunks(out, chunk_size, rows_fun, n_threads):
+    # Fills `out[start:end] = rows_fun(start)[: end - start]` for all chunks of
+    # `chunk_size` rows, distributing the chunks among `n_threads` threads.
+    n = out.shape[0]
+
+    def fill(start):
+        end = min(start + chunk_size, n)
+        out[start:end] = rows_fun(start)[: end - start]
+
+    if n_threads > 1:
+        with _ThreadPoolExecutor(n_threads) as pool:
+            list(pool.map(fill, range(0, n, chunk_size)))
+    else:
+        for start in range(0, n, chunk_size):
+            fill(start)
+    return out
+
+
+def _streaming_linear_operator(
+    operator: _AbstractOperator, chunk_size: int, symmetry=None
+) -> _LinearOperator:
+    """
+    Wraps an operator in a scipy LinearOperator whose matrix-vector product
+    computes the matrix elements on the fly, `chunk_size` rows at a time.
+
+    Neither the matrix nor the full list of basis states is ever stored, so the
+    memory used, besides the vectors themselves, is proportional to
+    `chunk_size * operator.max_conn_size` (times the order of the group if
+    `symmetry` is given).
+
+    If `symmetry` is a :class:`~netket.hilbert.index.SymmetryReducedHilbertIndex`,
+    the rows are those of the operator in the basis of the symmetry sector.
+
+    The chunks of jax operators are computed by `NETKET_NUMBA_NUM_THREADS`
+    threads, while numba operators compute every chunk with their own
+    multithreaded kernels.
+    """
+    if symmetry is None:
+        n = operator.hilbert.n_states
+        dtype = operator.dtype
+    else:
+        n = symmetry.n_states
+        dtype = _np.result_type(operator.dtype, symmetry.characters.dtype)
+
+    if isinstance(operator, _DiscreteJaxOperator):
+
+        def rows_fun(v, start):
+            # pad the last chunk to avoid recompilation
+            numbers = _jnp.arange(start, start + chunk_size) % n
+            if symmetry is None:
+                return _matvec_rows_jax(operator.hilbert, operator, numbers, v)
+            return _sector_matvec_rows_jax(symmetry, operator, numbers, v)
+
+        n_threads = _numba_num_threads()
+
+    else:
+        operator = operator.collect()
+
+        def rows_fun(v, start):
+            numbers = _np.arange(start, min(start + chunk_size, n))
+            return _matvec_rows_numba(operator, numbers, v, symmetry)
+
+        n_threads = 1
+
+    def matvec(v):
+        v = v.reshape(-1)
+        out = _np.empty(n, dtype=_np.result_type(dtype, v.dtype))
+        if isinstance(operator, _DiscreteJaxOperator):
+            v = _jnp.asarray(v)
+        return _fill_chunks(out, chunk_size, _partial(rows_fun, v), n_threads)
+
+    return _LinearOperator((n, n), matvec, dtype=dtype)
+
+
 def lanczos_ed(
     operator: _AbstractOperator,
     *,
     k: int = 1,
     compute_eigenvectors: bool = False,
     matrix_free: bool = False,
+    chunk_size: int | None = None,
+    symmetry=None,
+    solver: str = "arpack",
     scipy_args: dict | None = None,
 ):
     r"""Computes `first_n` smallest eigenvalues and, optionally, eigenvectors
     of a Hermitian operator using :meth:`scipy.sparse.linalg.eigsh`.
 
+    For large Hilbert spaces, specify `chunk_size` to compute the matrix elements
+    on the fly, `chunk_size` rows at a time, without ever storing the sparse
+    matrix or the list of all basis states. The memory is then dominated by the
+    Lanczos vectors used by ARPACK (about `2k+1` vectors of size `hilbert.n_states`),
+    or by the `3k` block vectors used by LOBPCG if `solver="lobpcg"`.
+
     Args:
         operator: NetKet operator to diagonalize.
         k: The number of eigenvalues to compute.
@@ -40,9 +171,22 @@ def lanczos_ed(
             eigenvectors has almost no performance benefits.
         matrix_free: If true, matrix elements are computed on the fly.
             Otherwise, the operator is first converted to a sparse matrix.
+        chunk_size: If specified, matrix elements are computed on the fly,
+            `chunk_size` rows of the matrix at a time (implies `matrix_free`).
+            Jax operators compute every chunk in a jitted kernel.
+        symmetry: Optional :class:`~netket.hilbert.index.SymmetryReducedHilbertIndex`.
+            If specified, only the eigenvalues in the corresponding symmetry sector
+            are computed, and the eigenvectors are expressed in the basis of the
+            sector (use :meth:`~netket.hilbert.index.SymmetryReducedHilbertIndex.to_full_space`
+            to convert them to the full basis). Combined with `matrix_free` or
+            `chunk_size`, the rows of the matrix in the sector are computed on the
+            fly from the representatives of the index.
+        solver: Either `"arpack"` (the default), to use
+            :meth:`scipy.sparse.linalg.eigsh`, or `"lobpcg"`, to use
+            :meth:`scipy.sparse.linalg.lobpcg` starting from random vectors.
         scipy_args: Additional keyword arguments passed to
-            :meth:`scipy.sparse.linalg.eigvalsh`. See the Scipy documentation for further
-            information.
+            :meth:`scipy.sparse.linalg.eigsh` or :meth:`scipy.sparse.linalg.lobpcg`.
+            See the Scipy documentation for further information.
 
     Returns:
         Either `w` or the tuple `(w, v)` depending on whether `compute_eigenvectors`
@@ -62,16 +206,25 @@ def lanczos_ed(
         >>> w
         array([-10.25166179, -10.05467898,  -8.69093921])
     """
-    from scipy.sparse.linalg import eigsh
+    from scipy.sparse.linalg import eigsh, lobpcg
+
+    if solver not in ("arpack", "lobpcg"):
+        raise ValueError(f"solver must be 'arpack' or 'lobpcg', got {solver}.")
 
     actual_scipy_args = {}
     if scipy_args:
         actual_scipy_args.update(scipy_args)
-    actual_scipy_args["which"] = "SA"
-    actual_scipy_args["k"] = k
-    actual_scipy_args["return_eigenvectors"] = compute_eigenvectors
 
-    if matrix_free:
+    if symmetry is not None and matrix_free and chunk_size is None:
+        chunk_size = symmetry.n_states
+
+    if chunk_size is not None:
+        A = _streaming_linear_operator(operator, chunk_size, symmetry)
+    elif symmetry is not None:
+        A = operator.to_sparse(symmetry=symmetry)
+        if isinstance(A, _JAXSparse):
+            A = _LinearOperator(A.shape, A.__matmul__, dtype=A.dtype)
+    elif matrix_free:
         # wrap the operator.to_linear_operator() in a scipy.sparse.linalg.LinearOperator
         n = operator.hilbert.n_states
         A = _LinearOperator(
@@ -86,6 +239,17 @@ def lanczos_ed(
             # wrap them in a scipy.sparse.linalg.LinearOperator
             A = _LinearOperator(A.shape, A.__matmul__, dtype=A.dtype)
 
+    if solver == "lobpcg":
+        X = _np.random.default_rng(0).normal(size=(A.shape[0], k))
+        w, v = lobpcg(A, X.astype(A.dtype), largest=False, **actual_scipy_args)
+        order = _np.argsort(w)
+        if not compute_eigenvectors:
+            return w[order]
+        return w[order], v[:, order]
+
+    actual_scipy_args["which"] = "SA"
+    actual_scipy_args["k"] = k
+    actual_scipy_args["return_eigenvectors"] = compute_eigenvectors
     result = eigsh(A, **actual_scipy_args)
 
     if not compute_eigenvectors:
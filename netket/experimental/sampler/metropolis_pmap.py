@@ -25,6 +25,7 @@ import numpy as np
 from flax import linen as nn
 
 from netket.utils import mpi, struct
+from netket.utils.deprecation import warn_deprecation
 from netket.utils.types import PyTree
 
 from netket.sampler import SamplerState
@@ -60,6 +61,13 @@ class MetropolisSamplerPmap(MetropolisSampler):
 
     This sampler is experimental. It's API might change without warnings in future NetKet releases.
 
+    .. deprecated:: 3.17
+
+        This sampler is deprecated. Enable the sharding mode by setting
+        `NETKET_EXPERIMENTAL_SHARDING=1` (and `NETKET_EXPERIMENTAL_SHARDING_CPU=XX`
+        on CPU) and use :class:`~netket.sampler.MetropolisSampler`, which runs
+        the chains of every device locally inside of `shard_map`.
+
     To parallelize on CPU, you should set the following environment variable before loading jax/NetKet,
     XLA_FLAGS="--xla_force_host_platform_device_count=XX", where XX is the number of desired cpu devices.
 
@@ -99,6 +107,12 @@ class MetropolisSamplerPmap(MetropolisSampler):
             dtype: The dtype of the states sampled (default = np.float32).
         """
 
+        warn_deprecation(
+            "MetropolisSamplerPmap is deprecated: set NETKET_EXPERIMENTAL_SHARDING=1 "
+            "and use netket.sampler.MetropolisSampler, which runs the chains of every "
+            "device locally inside of shard_map."
+        )
+
         n_devices = len(jax.devices())
 
         n_chains_undef = "n_chains" not in kwargs and "n_chains_per_rank" not in kwargs
@@ -25,6 +25,7 @@ from equinox import error_if
 
 from netket.utils.types import Array, DType
 from netket.jax import sharding
+from netket.jax._bitpacking import pack_bits, unpack_bits
 
 from .abstract_hilbert import AbstractHilbert
 from .index import is_indexable
@@ -302,6 +303,75 @@ class DiscreteHilbert(AbstractHilbert):
         """
         raise NotImplementedError()
 
+    @property
+    def supports_packed_states(self) -> bool:
+        r"""Whether states of this space can be stored in the bit-packed
+        representation, that is if all local dimensions are 2."""
+        return self.is_finite and all(s == 2 for s in self.shape)
+
+    def _check_supports_packed_states(self):
+        if not self.supports_packed_states:
+            raise TypeError(
+                "The bit-packed representation of states is only supported for "
+                f"Hilbert spaces with local dimension 2, but {self} has "
+                f"shape {self.shape}."
+            )
+
+    def states_to_packed(self, x: Array) -> jax.Array:
+        r"""
+        Converts a tensor of states to the bit-packed representation.
+
+        The local index (0 or 1) of every site is stored in one bit, so that a
+        state is represented by `ceil(hilbert.size/64)` unsigned 64-bit integers.
+        Site `i` is stored in word `i // 64`, with the most significant bit first.
+        Only supported if all local dimensions are 2 (see
+        :attr:`~netket.hilbert.DiscreteHilbert.supports_packed_states`).
+
+        This function can be jax-jitted.
+
+        Args:
+            x: a tensor of shape `(..., hilbert.size)` containing states of this
+                Hilbert space.
+
+        Returns:
+            a `uint64` tensor of shape `(..., ceil(hilbert.size/64))`.
+        """
+        self._check_supports_packed_states()
+        return pack_bits(self.states_to_local_indices(x))
+
+    def packed_to_states(self, x: Array, dtype: DType = None) -> jax.Array:
+        r"""
+        Inverse of :meth:`~netket.hilbert.DiscreteHilbert.states_to_packed`.
+
+        This function can be jax-jitted.
+
+        Args:
+            x: a `uint64` tensor of shape `(..., ceil(hilbert.size/64))`.
+            dtype: the dtype of the resulting states.
+
+        Returns:
+            a tensor of shape `(..., hilbert.size)` containing the states.
+        """
+        self._check_supports_packed_states()
+        return self.local_indices_to_states(
+            unpack_bits(x, self.size, dtype=jnp.int32), dtype=dtype
+        )
+
+    def packed_states_to_numbers(self, x: Array) -> jax.Array:
+        r"""Returns the basis state number corresponding to given bit-packed
+        states.
+
+        Equivalent to `hilbert.states_to_numbers(hilbert.packed_to_states(x))`,
+        but might avoid unpacking the states.
+
+        Args:
+            x: a `uint64` tensor of shape `(..., ceil(hilbert.size/64))`.
+
+        Returns:
+            Array of integers corresponding to states.
+        """
+        return self.states_to_numbers(self.packed_to_states(x))
+
     @property
     def is_indexable(self) -> bool:
         """Whether the space can be indexed with an integer"""
@@ -281,6 +281,16 @@ class HomogeneousHilbert(DiscreteHilbert):
 
         return self._hilbert_index.states_to_numbers(states)
 
+    def packed_states_to_numbers(self, x: Array) -> jax.Array:
+        self._check_supports_packed_states()
+        if not self.constrained and isinstance(
+            self._hilbert_index, UniformTensorProductHilbertIndex
+        ):
+            if not self.is_indexable:
+                raise RuntimeError("The hilbert space is too large to be indexed.")
+            return self._hilbert_index.packed_states_to_numbers(x)
+        return super().packed_states_to_numbers(x)
+
     def all_states(self) -> np.ndarray:
         r"""Returns all valid states of the Hilbert space.
 
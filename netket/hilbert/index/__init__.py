@@ -35,6 +35,7 @@ from .uniform_tensor import UniformTensorProductHilbertIndex
 from .constrained_generic import ConstrainedHilbertIndex, optimalConstrainedHilbertindex
 from .constrained_sum import SumConstrainedHilbertIndex
 from .constrained_sum_partitions import SumOnPartitionConstrainedHilbertIndex
+from .symmetric import SymmetryReducedHilbertIndex
 
 
 from netket.utils import _hide_submodules
@@ -0,0 +1,403 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from functools import partial
+
+import numpy as np
+from numba import jit, prange
+
+import jax
+import jax.numpy as jnp
+
+from netket.utils import struct
+from netket.utils.numba_threads import use_parallel_kernels
+from netket.utils.types import Array
+
+from .base import HilbertIndex
+
+
+def _is_uniform(hilbert) -> bool:
+    # Unconstrained spaces with the same local dimension on every site, whose
+    # states are numbered with the first site as the most significant digit.
+    return (
+        hilbert.is_finite
+        and not hilbert.constrained
+        and all(s == hilbert.shape[0] for s in hilbert.shape)
+    )
+
+
+def _uniform_basis(hilbert):
+    d = hilbert.shape[0]
+    return d ** jnp.arange(hilbert.size - 1, -1, -1, dtype=jnp.int64)
+
+
+def _full_states_to_numbers(hilbert, states):
+    # The numbers of basis states in the full space. They are computed as 64-bit
+    # integers for uniform spaces, which can have more than 2^31 states.
+    if _is_uniform(hilbert):
+        local_indices = hilbert.states_to_local_indices(states).astype(jnp.int64)
+        return local_indices @ _uniform_basis(hilbert)
+    return hilbert.states_to_numbers(states)
+
+
+def _full_numbers_to_states(hilbert, numbers):
+    # Inverse of `_full_states_to_numbers`.
+    if _is_uniform(hilbert):
+        local_indices = (numbers[..., None] // _uniform_basis(hilbert)) % (
+            hilbert.shape[0]
+        )
+        return hilbert.local_indices_to_states(local_indices)
+    return hilbert.numbers_to_states(numbers)
+
+
+def _uniform_orbit_data_kernel(
+    start, local_dim, permutations, characters, is_rep, norm2
+):
+    # Same as `_orbit_data` for the states `start, start + 1, ...` of a uniform
+    # space. A permuted state is smaller than the state if it has a smaller
+    # digit at the first site where they differ, so that most states, which are
+    # not representatives, are discarded after comparing a few digits with a
+    # few group elements.
+    n_group, n_sites = permutations.shape
+    for i in prange(is_rep.shape[0]):
+        digits = np.empty(n_sites, dtype=np.int64)
+        x = start + i
+        for j in range(n_sites - 1, -1, -1):
+            digits[j] = x % local_dim
+            x //= local_dim
+
+        is_rep[i] = True
+        norm2[i] = 0.0
+        for g in range(n_group):
+            diff = 0
+            for j in range(n_sites):
+                diff = digits[permutations[g, j]] - digits[j]
+                if diff != 0:
+                    break
+            if diff < 0:
+                is_rep[i] = False
+                break
+            if diff == 0:
+                norm2[i] += characters[g]
+        norm2[i] /= n_group
+
+
+_uniform_orbit_data = jit(nopython=True)(_uniform_orbit_data_kernel)
+_uniform_orbit_data_parallel = jit(nopython=True, parallel=True)(
+    _uniform_orbit_data_kernel
+)
+
+
+@partial(jax.jit, static_argnums=0)
+def _orbit_data(hilbert, permutations, characters, numbers):
+    # For every state, whether it is the representative of its orbit (the
+    # element with the smallest number) and the squared norm of its projection
+    # on the symmetry sector.
+    images = hilbert.states_to_numbers(
+        hilbert.numbers_to_states(numbers)[..., permutations]
+    )
+    is_representative = jnp.all(images >= numbers[:, None], axis=-1)
+    norm2 = jnp.mean(
+        jnp.where(images == numbers[:, None], characters.conj(), 0), axis=-1
+    ).real
+    return is_representative, norm2
+
+
+@jax.jit
+def _sector_matrix_elements(index, rows, x_primes, mels):
+    columns, phases, valid = index.canonicalize(x_primes)
+    values = mels * phases * index.norms[columns] / index.norms[rows]
+    return jnp.where(valid, columns, 0), jnp.where(valid, values, 0)
+
+
+@struct.dataclass
+class SymmetryReducedHilbertIndex(HilbertIndex):
+    r"""
+    Indexes the basis of a symmetry sector of an indexable Hilbert space.
+
+    Given a group of permutations :math:`G` of the sites, acting on the basis
+    states as :math:`U_g|x\rangle = |x_{g^{-1}(1)}, \dots, x_{g^{-1}(N)}\rangle`,
+    and a one-dimensional irrep :math:`\chi`, the sector is spanned by the
+    states :math:`|\psi\rangle` such that :math:`U_g|\psi\rangle = \chi(g)|\psi\rangle`.
+    Its basis is
+
+    .. math::
+
+        |\tilde r\rangle = \frac{1}{n_r |G|} \sum_{g\in G} \chi(g)^* U_g|r\rangle,
+
+    where :math:`r` runs over the representatives (the state with the smallest
+    number) of the orbits compatible with :math:`\chi`, and :math:`n_r` is the
+    normalization.
+
+    The numbers of this index enumerate the representatives in increasing
+    order, and every basis state is mapped to the number of the representative
+    of its orbit by :meth:`states_to_numbers`, which costs :math:`|G|` lookups in
+    the full Hilbert space and a binary search.
+
+    For unconstrained Hilbert spaces with the same local dimension on all sites,
+    such as `Spin(0.5, N)`, the states of the full space are numbered with 64-bit
+    integers, so that the full space can have more than :math:`2^{31}` states as
+    long as the sector has fewer.
+
+    Construct it with :meth:`from_group`.
+    """
+
+    hilbert: object = struct.field(pytree_node=False)
+    """The (indexable) Hilbert space that is reduced."""
+    permutations: Array
+    """Array of shape `(|G|, N)`, as returned by `PermutationGroup.to_array()`."""
+    characters: Array
+    """The characters :math:`\chi(g)` of the irrep for all group elements."""
+    representatives: Array
+    """Sorted numbers, in the full Hilbert space, of the representatives.
+    64-bit integers for uniform Hilbert spaces."""
+    norms: Array
+    """The normalizations :math:`n_r` of the representatives."""
+
+    @classmethod
+    def from_group(
+        cls, hilbert, group, character: Array | None = None, *, chunk_size=None
+    ) -> "SymmetryReducedHilbertIndex":
+        r"""
+        Constructs the index of a symmetry sector of `hilbert`.
+
+        The construction tests every state of the full Hilbert space, `chunk_size`
+        states at a time, and only stores the representatives of the sector, so
+        that the memory is proportional to the size of the sector but the time
+        is proportional to the size of the full space.
+
+        For uniform Hilbert spaces (see above) the test runs in a numba kernel,
+        multithreaded according to the `NETKET_NUMBA_NUM_THREADS` flag, which
+        discards a state as soon as a permutation of it is found to be smaller.
+        This costs a few operations for most states and :math:`O(|G| N)` for the
+        representatives, and is practical up to about :math:`2^{36}` states with
+        many threads. For other Hilbert spaces every state is compared with all
+        its :math:`|G|` images in a jitted kernel, which is practical up to
+        about :math:`2^{28}` states.
+
+        Args:
+            hilbert: An indexable discrete Hilbert space, or a uniform one with
+                more than :math:`2^{31}` states.
+            group: A :class:`~netket.utils.group.PermutationGroup` acting on the
+                sites of the Hilbert space. It must commute with the operators
+                that are represented in the sector.
+            character: The characters of a one-dimensional irrep of the group,
+                one for every element, for example a row of
+                `group.character_table()`. Defaults to the trivial irrep.
+            chunk_size: Number of states processed at once during the construction
+                (default: :math:`2^{20}` for uniform spaces and :math:`2^{16}`
+                otherwise).
+
+        Example:
+            Zero-momentum sector of a spin chain
+
+            >>> import netket as nk
+            >>> g = nk.graph.Chain(8)
+            >>> hi = nk.hilbert.Spin(0.5, 8)
+            >>> index = nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+            ...     hi, g.translation_group()
+            ... )
+            >>> index.n_states
+            36
+        """
+        if not (hilbert.is_indexable or _is_uniform(hilbert)):
+            raise ValueError(
+                "A symmetry reduced index can only be constructed for indexable "
+                "Hilbert spaces."
+            )
+
+        permutations = np.asarray(group.to_array())
+        if permutations.shape[1] != hilbert.size:
+            raise ValueError(
+                f"The group acts on {permutations.shape[1]} sites, but the Hilbert "
+                f"space has {hilbert.size} sites."
+            )
+
+        if character is None:
+            character = np.ones(permutations.shape[0])
+        character = np.asarray(character)
+        if character.shape != (permutations.shape[0],):
+            raise ValueError(
+                f"Expected one character for every one of the {permutations.shape[0]} "
+                f"group elements, got an array of shape {character.shape}."
+            )
+        if not np.allclose(np.abs(character), 1):
+            raise ValueError(
+                "Only one-dimensional irreps (characters of unit modulus) are "
+                "supported."
+            )
+        if np.allclose(character.imag, 0):
+            character = character.real.astype(np.float64)
+        else:
+            character = character.astype(np.complex128)
+
+        uniform = _is_uniform(hilbert)
+        if uniform:
+            n = int(np.prod(hilbert.shape, dtype=object))
+            if use_parallel_kernels():
+                orbit_data = _uniform_orbit_data_parallel
+            else:
+                orbit_data = _uniform_orbit_data
+        else:
+            n = hilbert.n_states
+        if chunk_size is None:
+            chunk_size = 2**20 if uniform else 2**16
+
+        # norm2 is either 0 or at least 1/|G|
+        tol = 0.5 / permutations.shape[0]
+        representatives = []
+        norms = []
+        for start in range(0, n, chunk_size):
+            if uniform:
+                size = min(chunk_size, n - start)
+                is_rep = np.empty(size, dtype=bool)
+                norm2 = np.empty(size, dtype=np.float64)
+                orbit_data(
+                    start,
+                    hilbert.shape[0],
+                    permutations.astype(np.int64),
+                    character.real,
+                    is_rep,
+                    norm2,
+                )
+                numbers = np.arange(start, start + size, dtype=np.int64)
+            else:
+                numbers = np.arange(start, min(start + chunk_size, n), dtype=np.int32)
+                is_rep, norm2 = _orbit_data(
+                    hilbert, jnp.asarray(permutations), jnp.asarray(character), numbers
+                )
+            keep = np.asarray(is_rep) & (np.asarray(norm2) > tol)
+            representatives.append(numbers[keep])
+            norms.append(np.sqrt(np.asarray(norm2)[keep]))
+
+        return cls(
+            hilbert,
+            jnp.asarray(permutations),
+            jnp.asarray(character),
+            jnp.asarray(np.concatenate(representatives)),
+            jnp.asarray(np.concatenate(norms)),
+        )
+
+    @property
+    def n_states(self) -> int:
+        return self.representatives.shape[0]
+
+    @property
+    def is_indexable(self) -> bool:
+        return True
+
+    @property
+    def size(self) -> int:
+        return self.hilbert.size
+
+    @jax.jit
+    def canonicalize(self, states: Array) -> tuple[Array, Array, Array]:
+        r"""
+        Maps a batch of basis states to the representatives of their orbit.
+
+        Args:
+            states: An array of shape `(..., N)`.
+
+        Returns:
+            A tuple `(numbers, phases, valid)` where `numbers` are the numbers of
+            the representatives in this index, `phases` are the characters
+            :math:`\chi(g)` of the group elements mapping the states onto their
+            representatives, and `valid` is False for the states whose orbit has
+            no component in the sector (for those, `numbers` is meaningless).
+        """
+        images = _full_states_to_numbers(self.hilbert, states[..., self.permutations])
+        g = jnp.argmin(images, axis=-1)
+        rep = jnp.take_along_axis(images, g[..., None], axis=-1)[..., 0]
+        numbers = jnp.searchsorted(self.representatives, rep)
+        numbers = jnp.minimum(numbers, self.n_states - 1)
+        valid = self.representatives[numbers] == rep
+        return numbers, self.characters[g], valid
+
+    @jax.jit
+    def states_to_numbers(self, states: Array) -> Array:
+        return self.canonicalize(states)[0]
+
+    @jax.jit
+    def numbers_to_states(self, numbers: Array) -> Array:
+        return _full_numbers_to_states(self.hilbert, self.representatives[numbers])
+
+    def all_states(self) -> Array:
+        return self.numbers_to_states(jnp.arange(self.n_states))
+
+    def sector_matrix_elements(
+        self, rows: Array, x_primes: Array, mels: Array, *, chunk_size: int = 16384
+    ) -> tuple[np.ndarray, np.ndarray]:
+        r"""
+        Converts the matrix elements :math:`\langle r|O|x'\rangle` of a symmetric
+        operator, where :math:`r` are representatives, to the matrix elements
+        :math:`\langle\tilde r|O|\tilde r'\rangle` in the basis of the sector.
+
+        Args:
+            rows: The numbers (in this index) of the representatives :math:`r`,
+                broadcastable to the shape of `mels`.
+            x_primes: The connected states, of shape `(*mels.shape, N)`.
+            mels: The matrix elements.
+            chunk_size: Number of matrix elements converted at once. The memory
+                cost is proportional to `chunk_size * |G| * N`.
+
+        Returns:
+            The flattened arrays `(columns, values)`. Connected states not
+            belonging to the sector have zero value.
+        """
+        mels = np.asarray(mels).ravel()
+        rows = np.broadcast_to(np.asarray(rows), np.shape(x_primes)[:-1]).ravel()
+        x_primes = np.asarray(x_primes).reshape(mels.shape[0], -1)
+
+        n = mels.shape[0]
+        columns = np.empty(n, dtype=np.int32)
+        values = np.empty(n, dtype=np.result_type(mels.dtype, self.characters.dtype))
+        for start in range(0, n, chunk_size):
+            end = min(start + chunk_size, n)
+            # pad the last chunk to avoid recompilation
+            idx = np.arange(start, start + chunk_size) % n
+            c, v = _sector_matrix_elements(self, rows[idx], x_primes[idx], mels[idx])
+            columns[start:end] = c[: end - start]
+            values[start:end] = v[: end - start]
+        return columns, values
+
+    def to_full_space(self, vectors: Array) -> np.ndarray:
+        r"""
+        Expresses vectors given in the basis of the sector in the basis of the
+        full Hilbert space.
+
+        Args:
+            vectors: An array of shape `(n_states,)` or `(n_states, k)`.
+
+        Returns:
+            An array of shape `(hilbert.n_states,)` or `(hilbert.n_states, k)`.
+        """
+        vectors = np.asarray(vectors)
+        n_group = self.permutations.shape[0]
+        images = np.asarray(
+            _full_states_to_numbers(
+                self.hilbert, self.all_states()[..., self.permutations]
+            )
+        )
+        weights = np.asarray(self.characters).conj() / (
+            n_group * np.asarray(self.norms)[:, None]
+        )
+        coeffs = weights.reshape(weights.shape + (1,) * (vectors.ndim - 1)) * (
+            vectors[:, None]
+        )
+        out = np.zeros(
+            (self.hilbert.n_states,) + vectors.shape[1:],
+            dtype=np.result_type(coeffs.dtype, vectors.dtype),
+        )
+        np.add.at(out, images.ravel(), coeffs.reshape((-1,) + vectors.shape[1:]))
+        return out
@@ -55,6 +55,22 @@ class UniformTensorProductHilbertIndex(HilbertIndex):
         local_numbers = self.local_index.states_to_numbers(states, dtype=jnp.int32)
         return local_numbers @ self._basis
 
+    @jax.jit
+    def packed_states_to_numbers(self, packed_states: Array) -> Array:
+        """
+        Converts bit-packed states (see :func:`netket.jax.pack_bits`) to
+        numbers. Only valid if the local space has 2 states.
+
+        As sites are packed most significant bit first, the number is obtained
+        by shifting the single packed word, without unpacking the states.
+        """
+        if self.local_size != 2:
+            raise TypeError("Packed states require a local dimension of 2.")
+        if packed_states.shape[-1] != 1 or self.size > 63:
+            raise RuntimeError("The hilbert space is too large to be indexed.")
+        shift = jnp.asarray(64 - self.size, dtype=packed_states.dtype)
+        return jnp.right_shift(packed_states[..., 0], shift).astype(jnp.int32)
+
     @jax.jit
     def numbers_to_states(self, numbers: Array) -> Array:
         local_numbers = (numbers[..., None] // self._basis) % self.local_size
@@ -26,6 +26,8 @@ This module *exports* two functions:
  states, considers σᵢ and returns a new state where that entry is different from the
  previous. The new configuration is selected with uniform probability among the local
  possible configurations.
+ - `flip_state_packed(hilb, key, states, indices)`, the equivalent of `flip_state`
+ for bit-packed states of spaces with local dimension 2.
 
 Hilbert spaces must at least implement a `random_state` to support sampling.
 `flip_state` is only necessary in order to use LocalRule samplers.
@@ -70,6 +72,6 @@ def flip_state_batch(hilb: Fock, key, σ, idx):
 from netket.utils import _hide_submodules
 
 from . import custom, doubled, homogeneous, fock, qubit, tensor_hilbert, particle
-from .base import flip_state, random_state
+from .base import flip_state, flip_state_packed, random_state
 
 _hide_submodules(__name__)
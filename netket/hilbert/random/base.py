@@ -18,10 +18,12 @@ from typing import Union
 from functools import partial
 
 import jax
+import jax.numpy as jnp
 import numpy as np
 
 from netket.utils.dispatch import dispatch
 from netket.jax.sharding import sharding_decorator
+from netket.jax._bitpacking import bit_mask
 
 Dim = Union[
     tuple[int], tuple[int, int], tuple[int, int, int], tuple[int, int, int, int]
@@ -108,6 +110,27 @@ def flip_state(hilb, key, state, indices):
         return flip_state_batch(hilb, key, state, indices)
 
 
+def flip_state_packed(hilb, key, state, indices):
+    r"""
+    Version of :func:`flip_state` acting on bit-packed states (see
+    :meth:`~netket.hilbert.DiscreteHilbert.states_to_packed`).
+
+    As packing is only supported for local dimension 2, the flip is
+    deterministic and amounts to a bitwise xor with the mask of the flipped
+    site, without unpacking the state. `key` is accepted for consistency with
+    :func:`flip_state`, but is not used.
+
+    Returns:
+        new_state: a packed state or batch of packed states, with one site flipped
+        old_vals: a scalar (or vector) of the old local indices (0 or 1) at the
+            flipped sites
+    """
+    hilb._check_supports_packed_states()
+    mask = bit_mask(indices, hilb.size).astype(state.dtype)
+    old_vals = (state & mask).any(axis=-1).astype(jnp.int8)
+    return state ^ mask, old_vals
+
+
 @dispatch
 def flip_state_scalar(hilb, key, state, indx):
     new_state, old_val = flip_state_batch(
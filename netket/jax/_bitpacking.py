@@ -0,0 +1,165 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Bit-packed representation of arrays of bits.
+#
+# A vector of N bits is stored in ceil(N/64) uint64 words. Bit i is stored in
+# word i // 64, at position 63 - i % 64 (most significant bit first), so that
+# for N <= 64 the packed word shifted right by 64 - N is the integer whose
+# binary representation, read left to right, is the vector of bits. This
+# matches the ordering used by NetKet to index Hilbert spaces.
+
+from functools import partial
+
+import numpy as np
+
+import jax
+import jax.numpy as jnp
+
+from netket.utils.types import Array, DType
+
+WORD_DTYPE = jnp.uint64
+WORD_SIZE = 64
+
+
+def n_words(n_bits: int) -> int:
+    """Number of uint64 words necessary to store `n_bits` bits."""
+    return -(-n_bits // WORD_SIZE)
+
+
+def _bit_weights(dtype=WORD_DTYPE):
+    # weights of the bits in a word, most significant first
+    return jnp.left_shift(
+        dtype(1), jnp.arange(WORD_SIZE - 1, -1, -1, dtype=dtype)
+    ).astype(dtype)
+
+
+def _pad_to_words(bits: Array, n_bits: int) -> Array:
+    pad = n_words(n_bits) * WORD_SIZE - n_bits
+    if pad > 0:
+        bits = jnp.pad(bits, [(0, 0)] * (bits.ndim - 1) + [(0, pad)])
+    return bits
+
+
+@jax.jit
+def pack_bits(bits: Array) -> Array:
+    """
+    Packs the last axis of an array of bits in uint64 words.
+
+    Every nonzero entry of `bits` is interpreted as a 1. The bit `i` is stored
+    in the word `i // 64` with the most significant bits first.
+
+    Args:
+        bits: An array of shape `(..., N)`.
+
+    Returns:
+        A `uint64` array of shape `(..., ceil(N/64))`.
+
+    Example:
+        >>> import jax.numpy as jnp
+        >>> import netket as nk
+        >>> x = nk.jax.pack_bits(jnp.array([1, 0, 1]))
+        >>> int(x[0] >> 61)
+        5
+    """
+    n_bits = bits.shape[-1]
+    bits = _pad_to_words((bits != 0).astype(WORD_DTYPE), n_bits)
+    bits = bits.reshape(bits.shape[:-1] + (n_words(n_bits), WORD_SIZE))
+    # bits are disjoint, so the sum is equivalent to a bitwise or
+    return (bits * _bit_weights()).sum(axis=-1, dtype=WORD_DTYPE)
+
+
+@partial(jax.jit, static_argnames=("n_bits", "dtype"))
+def unpack_bits(words: Array, n_bits: int, dtype: DType = jnp.int8) -> Array:
+    """
+    Inverse of :func:`~netket.jax.pack_bits`.
+
+    Args:
+        words: A `uint64` array of shape `(..., ceil(n_bits/64))`.
+        n_bits: The number of bits to unpack.
+        dtype: The dtype of the output (default: int8).
+
+    Returns:
+        An array of zeros and ones of shape `(..., n_bits)`.
+    """
+    if words.shape[-1] != n_words(n_bits):
+        raise ValueError(
+            f"Cannot unpack {n_bits} bits from {words.shape[-1]} words "
+            f"(expected {n_words(n_bits)})."
+        )
+    bits = (words[..., None] & _bit_weights()) != 0
+    bits = bits.reshape(words.shape[:-1] + (-1,))
+    return bits[..., :n_bits].astype(dtype)
+
+
+def popcount(words: Array) -> Array:
+    """Number of bits set in every (unsigned) integer of the array."""
+    return jax.lax.population_count(words)
+
+
+def parity(words: Array, axis: int = -1) -> Array:
+    """
+    Parity (0 or 1) of the total number of bits set along `axis` of a packed
+    array.
+    """
+    return jnp.bitwise_and(popcount(words).sum(axis=axis, dtype=np.int32), 1)
+
+
+@partial(jax.jit, static_argnames=("n_bits",))
+def bit_mask(i: Array, n_bits: int) -> Array:
+    """
+    Packed mask with only the bit `i` set.
+
+    Args:
+        i: The integer index (or array of indices) of the bit.
+        n_bits: Total number of bits.
+
+    Returns:
+        A `uint64` array of shape `(*i.shape, ceil(n_bits/64))`.
+    """
+    i = jnp.asarray(i)
+    word, offset = jnp.divmod(i, WORD_SIZE)
+    bit = jnp.left_shift(
+        WORD_DTYPE(1), (WORD_SIZE - 1 - offset).astype(WORD_DTYPE)
+    ).astype(WORD_DTYPE)
+    words = jnp.arange(n_words(n_bits))
+    return jnp.where(words == word[..., None], bit[..., None], WORD_DTYPE(0))
+
+
+@partial(jax.jit, static_argnames=("n_bits",))
+def bits_before_mask(i: Array, n_bits: int) -> Array:
+    """
+    Packed mask with all the bits `j < i` set.
+
+    Args:
+        i: The integer index (or array of indices) of the bit.
+        n_bits: Total number of bits.
+
+    Returns:
+        A `uint64` array of shape `(*i.shape, ceil(n_bits/64))`.
+    """
+    i = jnp.asarray(i)
+    word, offset = jnp.divmod(i, WORD_SIZE)
+    bit = jnp.left_shift(
+        WORD_DTYPE(1), (WORD_SIZE - 1 - offset).astype(WORD_DTYPE)
+    ).astype(WORD_DTYPE)
+    # all the bits more significant than `bit`
+    partial_word = ~(bit | (bit - WORD_DTYPE(1)))
+    all_ones = ~WORD_DTYPE(0)
+    words = jnp.arange(n_words(n_bits))
+    return jnp.where(
+        words < word[..., None],
+        all_ones,
+        jnp.where(words == word[..., None], partial_word[..., None], WORD_DTYPE(0)),
+    )
@@ -1,4 +1,5 @@
 import jax
+import jax.numpy as jnp
 from functools import partial
 
 
@@ -32,6 +33,25 @@ def _chunk(x, chunk_size=None):
     return x.reshape((n_chunks, chunk_size) + x.shape[1:])
 
 
+@_treeify
+def _pad_to_multiple(x, chunk_size, mode="edge"):
+    # pad the first axis of x to the next multiple of chunk_size, repeating the
+    # last element (mode="edge") or with zeros (mode="constant")
+    n_pad = -x.shape[0] % chunk_size
+    if n_pad == 0:
+        return x
+    return jnp.pad(x, [(0, n_pad)] + [(0, 0)] * (x.ndim - 1), mode=mode)
+
+
+@_treeify
+def _trim(x, n):
+    return x[:n]
+
+
+def _leading_dim(x):
+    return jax.tree_util.tree_leaves(x)[0].shape[0]
+
+
 def _chunk_size(x):
     b = set(map(lambda x: x.shape[:2], jax.tree_util.tree_leaves(x)))
     if len(b) != 1:
@@ -53,17 +73,27 @@ def unchunk(x_chunked):
     return _unchunk(x_chunked), partial(_chunk, chunk_size=_chunk_size(x_chunked))
 
 
-def chunk(x, chunk_size=None):
+def chunk(x, chunk_size=None, *, pad_mode=None):
     """
     Split an array (or a pytree of arrays) into chunks along the first axis
 
     Args:
         x: an array (or pytree of arrays)
         chunk_size: an integer or None (default)
-            The first axis in x must be a multiple of chunk_size
+            The first axis in x must be a multiple of chunk_size, unless `pad_mode`
+            is specified.
+        pad_mode: If specified, the first axis of x is padded to the next multiple of
+            chunk_size, either repeating the last element (`"edge"`) or with zeros
+            (`"constant"`).
     Returns: a pair (x_chunked, unchunk_fn) where
         - x_chunked is x reshaped to (-1, chunk_size)+x.shape[1:]
           if chunk_size is None then it defaults to x.shape[0], i.e. just one chunk
-        - unchunk_fn is a function which restores x given x_chunked
+        - unchunk_fn is a function which restores x given x_chunked, removing
+          the padding
     """
-    return _chunk(x, chunk_size), _unchunk
+    if pad_mode is None or chunk_size is None:
+        return _chunk(x, chunk_size), _unchunk
+
+    n = _leading_dim(x)
+    x = _pad_to_multiple(x, chunk_size, mode=pad_mode)
+    return _chunk(x, chunk_size), lambda y: _trim(_unchunk(y), n)
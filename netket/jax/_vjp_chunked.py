@@ -10,7 +10,13 @@ from netket.jax.sharding import sharding_decorator
 from ._utils_tree import compose
 from ._scanmap import scanmap, scan_append_reduce, _multimap
 from ._vjp import vjp as nkvjp
-from ._chunk_utils import _chunk as _tree_chunk, _unchunk as _tree_unchunk
+from ._chunk_utils import (
+    _chunk as _tree_chunk,
+    _unchunk as _tree_unchunk,
+    _pad_to_multiple,
+    _trim,
+    _leading_dim,
+)
 
 
 def _trash_tuple_elements(t, nums=()):
@@ -59,11 +65,18 @@ def __vjp_fun_chunked(
 ):
     append_cond = _append_cond_fun(primals, nondiff_argnums, chunk_argnums)
     scan_fun = partial(scan_append_reduce, append_cond=append_cond)
+    # If chunk_size does not divide the number of elements, the last chunk is
+    # padded with copies of the last element, whose cotangents are zero.
+    n_elements = _leading_dim(primals[chunk_argnums[0]])
     primals = tuple(
-        _tree_chunk(p, chunk_size) if i in chunk_argnums else p
+        _tree_chunk(_pad_to_multiple(p, chunk_size), chunk_size)
+        if i in chunk_argnums
+        else p
         for i, p in enumerate(primals)
     )
-    cotangents = _tree_chunk(cotangents, chunk_size)
+    cotangents = _tree_chunk(
+        _pad_to_multiple(cotangents, chunk_size, mode="constant"), chunk_size
+    )
     # cotangents, and whatever requested in primals; +2 since 0 is the function, and 1 is cotangents
     argnums = (1,) + tuple(map(lambda x: x + 2, chunk_argnums))
     res = scanmap(
@@ -72,7 +85,9 @@ def __vjp_fun_chunked(
         argnums=argnums,
     )(fun, cotangents, *primals)
 
-    return _multimap(lambda c, l: _tree_unchunk(l) if c else l, append_cond, res)
+    return _multimap(
+        lambda c, l: _trim(_tree_unchunk(l), n_elements) if c else l, append_cond, res
+    )
 
 
 def _gen_append_cond_vjp(primals, nondiff_argnums, chunk_argnums):
@@ -170,7 +185,8 @@ def vjp_chunked(
         chunk_argnums: an integer or tuple of integers indicating the primals which should be chunked.
             The leading dimension of each of the primals indicated must be the same as the output of fun.
         chunk_size: an integer indicating the size of the chunks over which the vjp is computed.
-            It must be a integer divisor of the primals specified in chunk_argnums.
+            If it does not divide the leading dimension of the primals specified in
+            chunk_argnums, the last chunk is padded.
         nondiff_argnums: an integer or tuple of integers indicating the primals which should not be differentiated with.
             Specifying the arguments which are not needed should increase performance.
         return_forward: whether the returned function should also return the output of the forward pass
@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from functools import partial
+
 import flax.linen as nn
 import jax.numpy as jnp
 from jax.nn.initializers import normal
@@ -36,36 +38,98 @@ class Jastrow(nn.Module):
     @nn.compact
     def __call__(self, x_in: Array):
         nv = x_in.shape[-1]
-        il = jnp.tril_indices(nv, k=-1)
 
         kernel = self.param(
             "kernel", self.kernel_init, (nv * (nv - 1) // 2,), self.param_dtype
         )
 
-        # .at[].set is VERY slow for complex128 numbers in jax.
-        # So we do it on the real-valued real and imaginary parts separately and then join them back
-        # See issue https://github.com/jax-ml/jax/issues/24872
-        if jnp.issubdtype(self.param_dtype, jnp.complex128):
-            Wr = (
-                jnp.zeros((nv, nv), dtype=kernel.real.dtype)
-                .at[il]
-                .set(kernel.real, unique_indices=True, indices_are_sorted=True)
-            )
-            Wi = (
-                jnp.zeros((nv, nv), dtype=kernel.imag.dtype)
-                .at[il]
-                .set(kernel.imag, unique_indices=True, indices_are_sorted=True)
-            )
-            W = Wr + 1j * Wi
-
-        else:
-            W = (
-                jnp.zeros((nv, nv), dtype=self.param_dtype)
-                .at[il]
-                .set(kernel, unique_indices=True, indices_are_sorted=True)
-            )
+        W = _lower_triangular_kernel(kernel, nv)
 
         W, x_in = promote_dtype(W, x_in, dtype=None)
         y = jnp.einsum("...i,ij,...j", x_in, W, x_in)
 
         return y
+
+    def _symmetric_kernel_rows(self, rows: Array, nv: int) -> Array:
+        # Gathers the rows `rows` of the symmetric matrix W + Wᵀ directly from the
+        # packed lower-triangular kernel. Out-of-bounds rows are filled with zeros.
+        kernel = self.variables["params"]["kernel"]
+        cols = jnp.arange(nv)
+        i = jnp.maximum(rows[..., None], cols)
+        j = jnp.minimum(rows[..., None], cols)
+        packed_index = i * (i - 1) // 2 + j
+        S_rows = jnp.take(kernel, packed_index, mode="fill", fill_value=0)
+        return jnp.where((i == j) | (rows[..., None] >= nv), 0, S_rows)
+
+    def init_fast_update(self, x_in: Array):
+        r"""
+        Computes the log-amplitude together with the cache used by the fast-update
+        protocol of :class:`~netket.sampler.MetropolisSampler`.
+
+        The cache contains the row sums :math:`r_i = \sum_j (W_{ij}+W_{ji}) s_j`,
+        which can be updated in :math:`O(N)` when a single site changes.
+        """
+        nv = x_in.shape[-1]
+        S = self._symmetric_kernel_rows(jnp.arange(nv), nv)
+        S, x_in = promote_dtype(S, x_in, dtype=None)
+
+        r = x_in @ S
+        y = 0.5 * jnp.einsum("...i,...i", x_in, r)
+        return y, {"log_value": y, "row_sums": r}
+
+    def update_fast_update(self, cache, x_in: Array, x_new: Array, sites: Array):
+        """
+        Updates the cache computed by :meth:`init_fast_update` after the
+        entries at `sites` of `x_in` have been changed to obtain `x_new`,
+        and returns the new log-amplitude together with the updated cache.
+
+        Entries of `sites` equal to `x_in.shape[-1]` are treated as padding.
+        """
+        nv = x_in.shape[-1]
+        # (batch, n_sites, nv)
+        S_rows = self._symmetric_kernel_rows(sites, nv)
+        S_rows, x_in, x_new = promote_dtype(S_rows, x_in, x_new, dtype=None)
+
+        take = partial(jnp.take_along_axis, axis=-1, mode="fill", fill_value=0)
+        delta = take(x_new, sites) - take(x_in, sites)
+        r = cache["row_sums"]
+        # (batch, n_sites, n_sites)
+        S_block = take(S_rows, sites[:, None, :])
+
+        # With y = ½ xᵀ S x, we have y(x + Δ) = y(x) + Δ·r + ½ Δᵀ S Δ
+        y = (
+            cache["log_value"]
+            + jnp.einsum("bs,bs->b", delta, take(r, sites))
+            + 0.5 * jnp.einsum("bs,bst,bt->b", delta, S_block, delta)
+        )
+        r = r + jnp.einsum("bs,bsj->bj", delta, S_rows)
+        return y, {"log_value": y, "row_sums": r}
+
+
+def _lower_triangular_kernel(kernel: Array, nv: int) -> Array:
+    il = jnp.tril_indices(nv, k=-1)
+
+    # .at[].set is VERY slow for complex128 numbers in jax.
+    # So we do it on the real-valued real and imaginary parts separately and then join them back
+    # See issue https://github.com/jax-ml/jax/issues/24872
+    if jnp.issubdtype(kernel.dtype, jnp.complex128):
+        Wr = (
+            jnp.zeros((nv, nv), dtype=kernel.real.dtype)
+            .at[il]
+            .set(kernel.real, unique_indices=True, indices_are_sorted=True)
+        )
+        Wi = (
+            jnp.zeros((nv, nv), dtype=kernel.imag.dtype)
+            .at[il]
+            .set(kernel.imag, unique_indices=True, indices_are_sorted=True)
+        )
+        W = Wr + 1j * Wi
+
+    else:
+        W = (
+            jnp.zeros((nv, nv), dtype=kernel.dtype)
+            .at[il]
+            .set(kernel, unique_indices=True, indices_are_sorted=True)
+        )
+
+    return W
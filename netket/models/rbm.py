@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from functools import partial
 from typing import Any
 
 import numpy as np
@@ -19,6 +20,7 @@ import numpy as np
 import jax
 from jax import numpy as jnp
 from flax import linen as nn
+from flax.linen.dtypes import promote_dtype
 from jax.nn.initializers import normal
 
 from netket.utils import HashableArray
@@ -80,6 +82,67 @@ class RBM(nn.Module):
         else:
             return x
 
+    def _fast_update_params(self):
+        params = self.variables["params"]
+        kernel = params["Dense"]["kernel"]
+        bias = params["Dense"]["bias"] if self.use_hidden_bias else None
+        v_bias = params["visible_bias"] if self.use_visible_bias else None
+        return kernel, bias, v_bias
+
+    def init_fast_update(self, input):
+        r"""
+        Computes the log-amplitude together with the cache used by the fast-update
+        protocol of :class:`~netket.sampler.MetropolisSampler`.
+
+        The cache contains the hidden-layer pre-activations and the visible-bias
+        contribution, which can be updated in :math:`O(N_\text{hidden})` when a
+        single site changes.
+        """
+        kernel, bias, v_bias = self._fast_update_params()
+        input, kernel, bias, v_bias = promote_dtype(
+            input, kernel, bias, v_bias, dtype=None
+        )
+
+        theta = jnp.dot(input, kernel, precision=self.precision)
+        if bias is not None:
+            theta = theta + bias
+        if v_bias is not None:
+            visible = jnp.dot(input, v_bias)
+        else:
+            visible = jnp.zeros(input.shape[:-1], dtype=theta.dtype)
+
+        log_psi = jnp.sum(self.activation(theta), axis=-1) + visible
+        return log_psi, {"theta": theta, "visible": visible}
+
+    def update_fast_update(self, cache, input, input_new, sites):
+        """
+        Updates the cache computed by :meth:`init_fast_update` after the
+        entries at `sites` of `input` have been changed to obtain `input_new`,
+        and returns the new log-amplitude together with the updated cache.
+
+        Entries of `sites` equal to `input.shape[-1]` are treated as padding.
+        """
+        kernel, bias, v_bias = self._fast_update_params()
+        input, input_new, kernel, v_bias = promote_dtype(
+            input, input_new, kernel, v_bias, dtype=None
+        )
+
+        take = partial(jnp.take_along_axis, axis=-1, mode="fill", fill_value=0)
+        delta = take(input_new, sites) - take(input, sites)
+        # (batch, n_sites, n_hidden)
+        kernel_rows = jnp.take(kernel, sites, axis=0, mode="fill", fill_value=0)
+
+        theta = cache["theta"] + jnp.einsum(
+            "bs,bsh->bh", delta, kernel_rows, precision=self.precision
+        )
+        visible = cache["visible"]
+        if v_bias is not None:
+            v_bias_sites = jnp.take(v_bias, sites, mode="fill", fill_value=0)
+            visible = visible + jnp.sum(delta * v_bias_sites, axis=-1)
+
+        log_psi = jnp.sum(self.activation(theta), axis=-1) + visible
+        return log_psi, {"theta": theta, "visible": visible}
+
 
 class RBMModPhase(nn.Module):
     r"""
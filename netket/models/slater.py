@@ -223,6 +223,33 @@ class Slater2nd(nn.Module):
 
         return log_sd(n)
 
+    def generalized_orbitals(self):
+        """
+        Returns the orbitals as a matrix of shape :code:`(hilbert.size, n_fermions)`,
+        such that the amplitude of a configuration is the determinant of the rows
+        of the occupied modes, taken in increasing order.
+
+        For spin-conserving Hartree-Fock, the orbitals of the different spin
+        sectors are the diagonal blocks of this matrix.
+        """
+        if self.generalized:
+            return self.orbitals
+
+        n_orbitals = self.hilbert.n_orbitals
+        M = jnp.zeros(
+            (self.hilbert.size, self.hilbert.n_fermions), dtype=self.param_dtype
+        )
+        i_start = 0
+        for i, (n_fermions_i, M_i) in enumerate(
+            zip(self.hilbert.n_fermions_per_spin, self.orbitals)
+        ):
+            M = M.at[
+                i * n_orbitals : (i + 1) * n_orbitals,
+                i_start : i_start + n_fermions_i,
+            ].set(M_i)
+            i_start += n_fermions_i
+        return M
+
 
 class MultiSlater2nd(nn.Module):
     r"""
@@ -265,34 +292,50 @@ class MultiSlater2nd(nn.Module):
     """Dtype of the orbital amplitudes."""
 
     @nn.compact
-    def __call__(self, n):
+    def _determinants(self):
         """
-        Assumes inputs are strings of 0,1 that specify which orbitals are occupied.
-        Spin sectors are assumed to follow the SpinOrbitalFermion's factorisation,
-        meaning that the first `n_orbitals` entries correspond to sector -1, the
-        second `n_orbitals` correspond to 0 ... etc.
+        The determinants, as a single :class:`~netket.models.Slater2nd` vmapped
+        over a leading axis of size :code:`n_determinants`.
         """
         if not self.n_determinants:
             raise ValueError(
                 "Number of determinants must be an integer greater than 0."
             )
-        # make extra axis with copies to run determinants in parallel
-        n_bc = jnp.broadcast_to(n, (self.n_determinants, *n.shape))
-        multi_log_det = nn.vmap(
+        return nn.vmap(
             Slater2nd,
             in_axes=0,
             out_axes=0,  # vmap over copied axis
             variable_axes={"params": 0},
             split_rngs={"params": True},
+            axis_size=self.n_determinants,
+            methods=["__call__", "generalized_orbitals"],
         )(
             self.hilbert,
             restricted=self.restricted,
             generalized=self.generalized,
             kernel_init=self.kernel_init,
             param_dtype=self.param_dtype,
-        )(
-            n_bc
         )
+
+    def __call__(self, n):
+        """
+        Assumes inputs are strings of 0,1 that specify which orbitals are occupied.
+        Spin sectors are assumed to follow the SpinOrbitalFermion's factorisation,
+        meaning that the first `n_orbitals` entries correspond to sector -1, the
+        second `n_orbitals` correspond to 0 ... etc.
+        """
+        # make extra axis with copies to run determinants in parallel
+        n_bc = jnp.broadcast_to(n, (self.n_determinants, *n.shape))
+        multi_log_det = self._determinants()(n_bc)
         # sum the determinants
         log_det_sum = nkjax.logsumexp_cplx(multi_log_det, axis=0)
         return log_det_sum
+
+    def generalized_orbitals(self):
+        """
+        Returns the orbitals of all the determinants as an array of shape
+        :code:`(n_determinants, hilbert.size, n_fermions)`.
+
+        See :meth:`~netket.models.Slater2nd.generalized_orbitals`.
+        """
+        return self._determinants().generalized_orbitals()
@@ -108,6 +108,14 @@ class MPSPeriodic(nn.Module):
 
         return jnp.log(ψ.astype(dtype_complex(self.param_dtype)))
 
+    def site_tensors(self):
+        r"""
+        Returns the tensors :math:`A[s_i]` of all the sites, of shape
+        :code:`(N, local_size, bond_dim, bond_dim)`.
+        """
+        # create all tensors in mps from unit cell
+        return jnp.tile(self.tensors, (self._L // self._symperiod, 1, 1, 1))
+
     def contract_mps(self, qn):
         """
         Internal function, used to contract the tensor network with some input
@@ -116,8 +124,7 @@ class MPSPeriodic(nn.Module):
         Args:
             qn: The input tensor to be contracted with this MPS
         """
-        # create all tensors in mps from unit cell
-        all_tensors = jnp.tile(self.tensors, (self._L // self._symperiod, 1, 1, 1))
+        all_tensors = self.site_tensors()
 
         edge = jnp.eye(self._D, dtype=self.param_dtype)
 
@@ -211,6 +218,23 @@ class MPSOpen(nn.Module):
 
         return jnp.log(ψ.astype(dtype_complex(self.param_dtype)))
 
+    def site_tensors(self):
+        r"""
+        Returns the tensors of all the sites, of shape
+        :code:`(N, local_size, bond_dim, bond_dim)`, such that
+        :math:`\Psi(s_1,\dots s_N) = \mathrm{Tr}\left[A[s_1]\dots A[s_N]\right]`.
+
+        The boundary vectors are stored in the first row of the tensors of the
+        first site and in the first column of those of the last site, the other
+        entries of which are zero.
+        """
+        d, D = self._d, self._D
+        left = jnp.zeros((d, D, D), dtype=self.param_dtype)
+        left = left.at[:, 0, :].set(self.left_tensors)
+        right = jnp.zeros((d, D, D), dtype=self.param_dtype)
+        right = right.at[:, :, 0].set(self.right_tensors)
+        return jnp.concatenate([left[None], self.middle_tensors, right[None]])
+
     def contract_mps(self, qn):
         """
         Internal function, used to contract the tensor network with some input
@@ -189,7 +189,7 @@ class DiscreteOperator(AbstractOperator):
 
         return out
 
-    def to_sparse(self) -> _csr_matrix:
+    def to_sparse(self, *, symmetry=None) -> _csr_matrix:
         r"""Returns the sparse matrix representation of the operator. Note that,
         in general, the size of the matrix is exponential in the number of quantum
         numbers, and this operation should thus only be performed for
@@ -197,23 +197,38 @@ class DiscreteOperator(AbstractOperator):
 
         This method requires an indexable Hilbert space.
 
+        Args:
+            symmetry: Optional :class:`~netket.hilbert.index.SymmetryReducedHilbertIndex`.
+                If specified, returns the matrix of the operator restricted to the
+                corresponding symmetry sector, in the basis of the sector. The
+                operator must commute with the symmetry group.
+
         Returns:
             The sparse matrix representation of the operator.
         """
         concrete_op = self.collect()
         hilb = self.hilbert
 
-        x = hilb.all_states()
+        if symmetry is None:
+            x = hilb.all_states()
+        else:
+            x = np.asarray(symmetry.all_states())
 
         sections = np.empty(x.shape[0], dtype=np.int32)
         x_prime, mels = concrete_op.get_conn_flattened(x, sections)
 
-        numbers = hilb.states_to_numbers(x_prime)
-
         sections1 = np.empty(sections.size + 1, dtype=np.int32)
         sections1[1:] = sections
         sections1[0] = 0
 
+        if symmetry is not None:
+            rows = np.repeat(np.arange(x.shape[0]), np.diff(sections1))
+            numbers, mels = symmetry.sector_matrix_elements(rows, x_prime, mels)
+            n = symmetry.n_states
+            return _csr_matrix((mels, numbers, sections1), shape=(n, n))
+
+        numbers = hilb.states_to_numbers(x_prime)
+
         ## eliminate duplicates from numbers
         # rows_indices = compute_row_indices(hilb.states_to_numbers(x), sections1)
 
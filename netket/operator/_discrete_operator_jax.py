@@ -137,6 +137,107 @@ class DiscreteJaxOperator(DiscreteOperator):
             associated to each x' for every batch.
         """
 
+    def get_conn_padded_offdiagonal(
+        self, x: jax.Array
+    ) -> tuple[jax.Array, jax.Array, jax.Array]:
+        r"""Version of :meth:`~netket.operator.DiscreteJaxOperator.get_conn_padded`
+        returning the diagonal matrix elements :math:`O(x,x)` separately from the
+        other connected elements. This can be executed inside of a Jax function
+        transformation.
+
+        This is used when computing local estimators, where the diagonal element
+        does not require evaluating the wavefunction on :math:`x` a second time.
+        The default implementation returns a zero diagonal together with all the
+        connected elements. Operators whose diagonal element is at a known
+        position override it so that :math:`x` is not among the returned
+        connected states, except as padding.
+
+        Args:
+            x : A N-tensor of shape :math:`(...,hilbert.size)` containing
+                the batch/batches of quantum numbers :math:`x`.
+
+        Returns:
+            **(mels_diag, x_primes, mels)**: The diagonal matrix elements, in a
+            (N-1)-tensor, the other connected states x', in a N+1-tensor and the
+            N-tensor containing the matrix elements :math:`O(x,x')`.
+        """
+        xp, mels = self.get_conn_padded(x)
+        return jnp.zeros(mels.shape[:-1], dtype=mels.dtype), xp, mels
+
+    def get_conn_padded_packed(self, x: jax.Array) -> tuple[jax.Array, jax.Array]:
+        r"""Version of :meth:`~netket.operator.DiscreteJaxOperator.get_conn_padded`
+        acting on bit-packed states (see
+        :meth:`~netket.hilbert.DiscreteHilbert.states_to_packed`).
+
+        This can be executed inside of a Jax function transformation.
+        The default implementation unpacks the states, calls
+        :meth:`~netket.operator.DiscreteJaxOperator.get_conn_padded` and packs
+        the connected states again. Operators that can compute the connected
+        elements directly on the packed representation override it.
+
+        Args:
+            x : A `uint64` tensor of shape :math:`(..., \lceil M/64 \rceil)`
+                containing the batch of packed states, where :math:`M` is the
+                size of the hilbert space.
+
+        Returns:
+            **(x_primes, mels)**: The packed connected states x', in a N+1-tensor
+            and an N-tensor containing the matrix elements :math:`O(x,x')`.
+        """
+        xp, mels = self.get_conn_padded(self.hilbert.packed_to_states(x))
+        return self.hilbert.states_to_packed(xp), mels
+
+    def sample_conn(
+        self, key: jax.Array, x: jax.Array, *, weighted: bool = False
+    ) -> tuple[jax.Array, jax.Array]:
+        r"""Samples one state :math:`x'` connected to every state :math:`x` in the
+        batch. This can be executed inside of a Jax function transformation.
+
+        The state is chosen with probability :math:`q(x\rightarrow x')` uniform
+        among the connected states, or proportional to :math:`|O(x,x')|` if
+        `weighted=True`. The method also returns the logarithm of the ratio
+        :math:`q(x'\rightarrow x)/q(x\rightarrow x')` of the probabilities of the
+        reverse and of the forward move, which is the correction to the
+        acceptance probability of a Metropolis move proposing :math:`x'`. This
+        assumes that the operator is hermitian.
+
+        The default implementation computes all the connected elements of
+        :math:`x` and of :math:`x'`. Operators that are sums of many terms
+        override it to sample a single term, at a cost that is independent
+        of the number of terms, when this gives a valid proposal.
+
+        Args:
+            key: The random key.
+            x: A tensor of shape :math:`(..., hilbert.size)` containing the batch
+                of quantum numbers :math:`x`.
+            weighted: Whether to choose the connected states with probability
+                proportional to the absolute value of the matrix element
+                (default: False).
+
+        Returns:
+            **(x_proposed, log_prob_corr)**: The proposed states, with the same
+            shape as `x`, and the logarithm of the ratio between the probabilities
+            of the reverse and of the forward moves.
+        """
+        xp, mels = self.get_conn_padded(x)
+
+        def _weights(mels):
+            if weighted:
+                return jnp.abs(mels)
+            return (jnp.abs(mels) > 0).astype(jnp.abs(mels).dtype)
+
+        w = _weights(mels)
+        i = jax.random.categorical(key, jnp.log(w))
+        # select the element with a mask to avoid a gather
+        mask = jnp.arange(w.shape[-1]) == i[..., None]
+        x_proposed = (xp * mask[..., None]).sum(axis=-2, dtype=xp.dtype)
+
+        _, mels_proposed = self.get_conn_padded(x_proposed)
+        w_proposed = _weights(mels_proposed)
+
+        log_prob_corr = jnp.log(w.sum(axis=-1)) - jnp.log(w_proposed.sum(axis=-1))
+        return x_proposed, log_prob_corr
+
     def get_conn_flattened(
         self, x: np.ndarray, sections: np.ndarray
     ) -> tuple[np.ndarray, np.ndarray]:
@@ -202,7 +303,7 @@ class DiscreteJaxOperator(DiscreteOperator):
             out[:] = _n_conn
         return out
 
-    def to_sparse(self) -> JAXSparse:
+    def to_sparse(self, *, symmetry=None) -> JAXSparse:
         r"""Returns the sparse matrix representation of the operator. Note that,
         in general, the size of the matrix is exponential in the number of quantum
         numbers, and this operation should thus only be performed for
@@ -210,6 +311,12 @@ class DiscreteJaxOperator(DiscreteOperator):
 
         This method requires an indexable Hilbert space.
 
+        Args:
+            symmetry: Optional :class:`~netket.hilbert.index.SymmetryReducedHilbertIndex`.
+                If specified, returns the matrix of the operator restricted to the
+                corresponding symmetry sector, in the basis of the sector. The
+                operator must commute with the symmetry group.
+
         Returns:
             The sparse jax matrix representation of the operator.
         """
@@ -218,12 +325,18 @@ class DiscreteJaxOperator(DiscreteOperator):
         # replication of all_states will lead to a crash when
         # the n_samples cannot be divided by the number of ranks.
         # this should be fixed.
-        x = self.hilbert.all_states()
+        if symmetry is None:
+            x = self.hilbert.all_states()
+        else:
+            x = symmetry.all_states()
         n = x.shape[0]
         xp, mels = self.get_conn_padded(x)
-        a = mels.ravel()
         i = np.broadcast_to(np.arange(n)[..., None], mels.shape).ravel()
-        j = self.hilbert.states_to_numbers(xp).ravel()
+        if symmetry is None:
+            a = mels.ravel()
+            j = self.hilbert.states_to_numbers(xp).ravel()
+        else:
+            j, a = symmetry.sector_matrix_elements(i, xp, mels)
         ij = np.concatenate((i[:, None], j[:, None]), axis=1)
         return BCSR.from_bcoo(BCOO((a, ij), shape=(n, n)))
 
@@ -263,6 +376,30 @@ class DiscreteJaxOperator(DiscreteOperator):
             sparse_mat_scipy, dims=[list(self.hilbert.shape), list(self.hilbert.shape)]
         )
 
+    def __add__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            from netket.operator import SumOperatorJax
+
+            return SumOperatorJax(self, other)
+        return NotImplemented
+
+    def __radd__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            from netket.operator import SumOperatorJax
+
+            return SumOperatorJax(other, self)
+        return NotImplemented
+
+    def __sub__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            return self + (-other)
+        return NotImplemented
+
+    def __rsub__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            return other + (-self)
+        return NotImplemented
+
     def __matmul__(self, other):
         if isinstance(other, JAXSparse):
             return self.apply(other.todense())
@@ -292,3 +429,17 @@ class DiscreteJaxOperator(DiscreteOperator):
         If this is a JAX operator does nothing.
         """
         return self
+
+
+def _is_other_jax_operator(op, other, base: type) -> bool:
+    """
+    Returns True if `op` and `other` are both jax operators, but `other` is not
+    an instance of `base` and cannot be summed to `op` in an operator of the
+    same type. Such operators are summed with a
+    :class:`~netket.operator.SumOperatorJax`.
+    """
+    return (
+        isinstance(op, DiscreteJaxOperator)
+        and isinstance(other, DiscreteJaxOperator)
+        and not isinstance(other, base)
+    )
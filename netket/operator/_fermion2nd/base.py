@@ -19,6 +19,10 @@ from numbers import Number
 
 from netket.utils.types import DType
 from netket.operator import DiscreteOperator, Transpose
+from netket.operator._discrete_operator_jax import (
+    DiscreteJaxOperator,
+    _is_other_jax_operator,
+)
 from netket.operator._pauli_strings.base import _count_of_locations
 from netket.hilbert import AbstractHilbert
 from netket.utils.numbers import is_scalar, dtype as _dtype
@@ -387,6 +391,8 @@ class FermionOperator2ndBase(DiscreteOperator):
         return self.__add__(other)
 
     def __add__(self, other):
+        if _is_other_jax_operator(self, other, FermionOperator2ndBase):
+            return DiscreteJaxOperator.__add__(self, other)
         dtype = np.promote_types(self.dtype, _dtype(other))
         op = self.copy(dtype=dtype)
         return op.__iadd__(other)
@@ -396,6 +402,8 @@ class FermionOperator2ndBase(DiscreteOperator):
             return self + self.__class__(
                 self.hilbert, constant=other, dtype=self.dtype, cutoff=self._cutoff
             )
+        if _is_other_jax_operator(self, other, FermionOperator2ndBase):
+            return NotImplemented
         if not isinstance(other, FermionOperator2ndBase):  # pragma: no cover
             raise NotImplementedError(
                 f"In-place addition not implemented for {type(self)} "
@@ -12,7 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from collections import Counter
 from functools import partial, wraps
+import warnings
 
 import jax
 import jax.numpy as jnp
@@ -25,9 +27,10 @@ from netket.operator import DiscreteJaxOperator
 from netket.hilbert.abstract_hilbert import AbstractHilbert
 from netket.utils.types import DType
 from netket.jax.sharding import sharding_decorator
+from netket.jax._bitpacking import WORD_SIZE, bit_mask, bits_before_mask, parity
 
 from .base import FermionOperator2ndBase
-from .utils import _is_diag_term
+from .utils import _is_diag_term, _normal_order_term, transpose_term
 
 
 @partial(jax.vmap, in_axes=(0, None, None))
@@ -248,6 +251,56 @@ def apply_terms_scan_bits(
     return x_res.astype(x.dtype), *res
 
 
+def _apply_term_scan_packed(x, weight, sites, daggers, unroll=1):
+    # same as _apply_term_scan, acting on states bit-packed in uint64 words
+    # (see netket.jax.pack_bits)
+    if len(sites) == 0:  # constant diagonal term
+        return x, jnp.full(x.shape[:-1], weight), jnp.full(x.shape[:-1], True)
+
+    assert daggers.dtype == jnp.bool_
+    assert x.dtype == jnp.uint64
+    n_bits = x.shape[-1] * WORD_SIZE
+
+    sgn = jnp.zeros(x.shape[:-1], dtype=jnp.bool_)
+    zero = jnp.zeros(x.shape[:-1], dtype=jnp.bool_)
+    init = x, sgn, zero
+    xs = sites, daggers
+
+    def f(carry, xs):
+        site, dagger = xs
+        x_, sgn, zero = carry
+        site_mask = bit_mask(site, n_bits)
+
+        # check if we did σ⁺|1⟩=0 or σ⁻|0⟩=0
+        occupied = (x_ & site_mask).any(axis=-1)
+        zero = zero | (occupied == dagger)
+
+        # compute sign from σᶻ on all sites before the current site
+        sgn = sgn ^ parity(x_ & bits_before_mask(site, n_bits)).astype(jnp.bool_)
+
+        # apply σ⁻ / σ⁺. If the matrix element is not zero this is a flip
+        x_new = x_ ^ site_mask
+
+        return (x_new, sgn, zero), None
+
+    (x_final, sgn, zero), _ = jax.lax.scan(f, init, xs, unroll=unroll)
+
+    sign = 1 - 2 * sgn.astype(weight.dtype)
+    not_zero = ~zero
+    w_final = weight * not_zero * sign
+    return x_final, w_final, not_zero
+
+
+@partial(jax.vmap, in_axes=(None, 0, 0, 0, None), out_axes=(-2, -1, -1))
+def _apply_terms_scan_packed(x, w, sites, daggers, unroll):
+    return _apply_term_scan_packed(x, w, sites, daggers, unroll=unroll)
+
+
+@partial(jax.jit, static_argnums=4)
+def apply_terms_scan_packed(x, w, sites, daggers, unroll=4):
+    return _apply_terms_scan_packed(x, w, sites, daggers.astype(jnp.bool_), unroll)
+
+
 # mostly masks, some indexing
 def _apply_term_masks(x, w, sites, daggers):
     # sites can be an unsigned int
@@ -502,6 +555,28 @@ def n_conn_jax(dtype, tl_diag, tl_offdiag, x, apply_terms_fun=apply_terms_scan):
     return n_conn
 
 
+@jax.jit
+def sample_conn_jax(tl_offdiag, key, x):
+    # Applies to every x one off-diagonal term chosen uniformly. If the term
+    # annihilates x, x is returned.
+    n_terms = [w.shape[0] for w, _, _ in tl_offdiag]
+    batch_shape = x.shape[:-1]
+    x_flat = x.reshape(-1, x.shape[-1]).astype(jnp.bool_)
+    i = jax.random.randint(key, x_flat.shape[:-1], 0, max(sum(n_terms), 1))
+
+    xp = x_flat
+    offset = 0
+    for (w, sites, daggers), n in zip(tl_offdiag, n_terms):
+        j = jnp.clip(i - offset, 0, n - 1)
+        xp_, _, nonzero = jax.vmap(_apply_term_scan)(
+            x_flat, w[j], sites[j], daggers[j]
+        )
+        selected = (i >= offset) & (i < offset + n) & nonzero
+        xp = jnp.where(selected[:, None], xp_, xp)
+        offset += n
+    return xp.reshape(x.shape).astype(x.dtype), jnp.zeros(batch_shape)
+
+
 @register_pytree_node_class
 class FermionOperator2ndJax(FermionOperator2ndBase, DiscreteJaxOperator):
     r"""
@@ -658,6 +733,58 @@ class FermionOperator2ndJax(FermionOperator2ndBase, DiscreteJaxOperator):
         # alternatively we could return success
         return xp, mels
 
+    def get_conn_padded_packed(self, x):
+        self._setup()
+        xp, mels, _ = get_conn_padded_jax(
+            self._max_conn_size,
+            self._dtype,
+            self._terms_list_diag,
+            self._terms_list_offdiag,
+            x,
+            apply_terms_fun=apply_terms_scan_packed,
+        )
+        return xp, mels
+
+    @property
+    def _offdiag_terms_closed_under_adjoint(self) -> bool:
+        # If the adjoint of every off-diagonal term is also a term, as is the
+        # case for hermitian operators, the number of terms mapping x to x' is
+        # the same as the number of terms mapping x' to x. The terms are
+        # compared after normal ordering, so that for example 0 1^ is
+        # recognized as the adjoint of 0^ 1.
+        def _key(term):
+            return frozenset(tuple(t) for t in _normal_order_term(term)[0])
+
+        terms = [t for t in self._operators if not _is_diag_term(t)]
+        return Counter(map(_key, terms)) == Counter(
+            _key(transpose_term(t)) for t in terms
+        )
+
+    def sample_conn(self, key, x, *, weighted=False):
+        r"""Samples one state :math:`x'` connected to every state :math:`x` in the
+        batch. See :meth:`~netket.operator.DiscreteJaxOperator.sample_conn`.
+
+        If `weighted=False` and the adjoint of every off-diagonal term is also a
+        term of the operator (up to normal ordering), the state is obtained by
+        applying a single off-diagonal term chosen uniformly, which is a
+        symmetric proposal whose cost does not depend on the number of terms.
+        Otherwise, all the connected elements of :math:`x` and :math:`x'` are
+        computed, and a warning is raised if `weighted=False`.
+        """
+        self._setup()
+        if weighted:
+            return super().sample_conn(key, x, weighted=weighted)
+        if not self._offdiag_terms_closed_under_adjoint:
+            warnings.warn(
+                "The adjoint of some off-diagonal terms of the operator is not a "
+                "term, so all the connected elements are computed to sample a "
+                "connected state. Add the missing adjoint terms (the operator "
+                "should be hermitian) to sample a single term.",
+                stacklevel=2,
+            )
+            return super().sample_conn(key, x, weighted=weighted)
+        return sample_conn_jax(self._terms_list_offdiag, key, x)
+
     def n_conn(self, x):
         self._setup()
         if self._mode == "scan":
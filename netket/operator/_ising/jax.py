@@ -77,6 +77,16 @@ class IsingJax(IsingBase, DiscreteJaxOperator):
         xp = self.hilbert.local_indices_to_states(xp_ids, dtype=x.dtype)
         return xp, mels
 
+    @jax.jit
+    @wraps(DiscreteJaxOperator.get_conn_padded_offdiagonal)
+    def get_conn_padded_offdiagonal(self, x):
+        xp, mels = self.get_conn_padded(x)
+        if isinstance(self.h, StaticZero):
+            # keep one (padding) connected element
+            return mels[..., 0], xp, jnp.zeros_like(mels)
+        # the diagonal element is always the first one
+        return mels[..., 0], xp[..., 1:, :], mels[..., 1:]
+
     def to_numba_operator(self) -> "Ising":  # noqa: F821
         """
         Returns the standard (numba) version of this operator, which is an
@@ -26,6 +26,7 @@ from netket.utils.types import DType, Array
 from netket.utils.numbers import dtype as _dtype, is_scalar
 
 from .._discrete_operator import DiscreteOperator
+from .._discrete_operator_jax import DiscreteJaxOperator, _is_other_jax_operator
 from .._lazy import Transpose
 
 from .helpers import (
@@ -273,6 +274,8 @@ class LocalOperatorBase(DiscreteOperator):
         return -1 * self
 
     def __add__(self, other: Union["LocalOperatorBase", numbers.Number]):
+        if _is_other_jax_operator(self, other, LocalOperatorBase):
+            return DiscreteJaxOperator.__add__(self, other)
         op = self.copy(dtype=jnp.promote_types(self.dtype, _dtype(other)))
         op = op.__iadd__(other)
         return op
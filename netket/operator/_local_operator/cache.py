@@ -0,0 +1,137 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import hashlib
+import os
+import tempfile
+from collections import OrderedDict
+
+import numpy as np
+from scipy import sparse
+
+from netket import config
+from netket.hilbert import AbstractHilbert
+from netket.utils.types import DType
+
+from .compile_helpers import pack_internals
+
+# Bump this if the layout of the arrays returned by `pack_internals` changes,
+# to invalidate the files cached on disk by previous versions.
+_PACKED_FORMAT_VERSION = 1
+
+# Maximum number of packed operators kept in memory by every process.
+_MEMORY_CACHE_SIZE = 32
+_memory_cache: OrderedDict[str, dict] = OrderedDict()
+
+
+def operator_content_hash(
+    hilbert: AbstractHilbert,
+    operators_dict: dict,
+    constant,
+    dtype: DType,
+    mel_cutoff: float,
+) -> str:
+    """
+    Computes a hash identifying the packed representation of a local operator.
+
+    Two operators with the same hash are guaranteed to give the same output
+    when packed with :func:`pack_internals`.
+    """
+    h = hashlib.sha256()
+    header = (
+        _PACKED_FORMAT_VERSION,
+        tuple(int(s) for s in hilbert.shape),
+        np.dtype(dtype).str,
+        float(mel_cutoff),
+        complex(constant),
+    )
+    h.update(repr(header).encode())
+    for acting_on, op in operators_dict.items():
+        h.update(np.asarray(acting_on, dtype=np.int64).tobytes())
+        if sparse.issparse(op):
+            op = op.tocsr()
+            h.update(b"csr" + repr((op.shape, op.dtype.str)).encode())
+            h.update(np.ascontiguousarray(op.data).tobytes())
+            h.update(np.ascontiguousarray(op.indices, dtype=np.int64).tobytes())
+            h.update(np.ascontiguousarray(op.indptr, dtype=np.int64).tobytes())
+        else:
+            op = np.ascontiguousarray(op)
+            h.update(b"dense" + repr((op.shape, op.dtype.str)).encode())
+            h.update(op.tobytes())
+    return h.hexdigest()
+
+
+def _load(path: str) -> dict | None:
+    try:
+        with np.load(path, allow_pickle=False) as f:
+            data = {k: f[k] for k in f.files}
+    except (OSError, ValueError, EOFError):
+        # missing or corrupted file: it will be overwritten
+        return None
+    data["nonzero_diagonal"] = bool(data["nonzero_diagonal"])
+    data["max_conn_size"] = int(data["max_conn_size"])
+    return data
+
+
+def _save(path: str, data: dict):
+    # Write to a temporary file and atomically move it in place, so that many
+    # processes populating the cache at the same time never read partial files.
+    directory = os.path.dirname(path)
+    os.makedirs(directory, exist_ok=True)
+    fd, tmp_path = tempfile.mkstemp(dir=directory, suffix=".npz.tmp")
+    try:
+        with os.fdopen(fd, "wb") as f:
+            np.savez(f, **data)
+        os.replace(tmp_path, path)
+    except OSError:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+
+
+def cached_pack_internals(
+    hilbert: AbstractHilbert,
+    operators_dict: dict,
+    constant,
+    dtype: DType,
+    mel_cutoff: float,
+) -> dict:
+    """
+    Equivalent to :func:`pack_internals`, but if the flag
+    `NETKET_LOCAL_OPERATOR_CACHE_DIR` is set the result is cached in memory and
+    on disk, keyed by the hash of the content of the operator.
+
+    The returned arrays might be shared among several operators and must not
+    be modified in place.
+    """
+    cache_dir = config.netket_local_operator_cache_dir
+    if not cache_dir:
+        return pack_internals(hilbert, operators_dict, constant, dtype, mel_cutoff)
+
+    key = operator_content_hash(hilbert, operators_dict, constant, dtype, mel_cutoff)
+
+    data = _memory_cache.get(key, None)
+    if data is not None:
+        _memory_cache.move_to_end(key)
+        return data
+
+    path = os.path.join(cache_dir, f"local_operator_{key}.npz")
+    data = _load(path)
+    if data is None:
+        data = pack_internals(hilbert, operators_dict, constant, dtype, mel_cutoff)
+        _save(path, data)
+
+    _memory_cache[key] = data
+    if len(_memory_cache) > _MEMORY_CACHE_SIZE:
+        _memory_cache.popitem(last=False)
+    return data
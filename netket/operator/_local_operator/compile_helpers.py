@@ -218,7 +218,7 @@ def pack_internals_jax(
     return data
 
 
-@numba.jit(nopython=True)
+@numba.jit(nopython=True, cache=True)
 def _append_matrix(
     operator,
     acting_size,
@@ -257,7 +257,7 @@ def _append_matrix(
                 n_conns[i] += 1  # k_conn=k_conn+1
 
 
-@numba.jit(nopython=True)
+@numba.jit(nopython=True, cache=True)
 def _append_matrix_sparse(
     data,
     indices,
@@ -298,7 +298,7 @@ def _append_matrix_sparse(
                 n_conns[i] += 1
 
 
-@numba.jit(nopython=True)
+@numba.jit(nopython=True, cache=True)
 def _number_to_state(number, hilbert_size_per_site, out):
     out[:] = 0
     size = out.shape[0]
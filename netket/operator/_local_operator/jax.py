@@ -273,6 +273,21 @@ class LocalOperatorJax(LocalOperatorBase, DiscreteJaxOperator):
         xp, mels, _ = self._get_conn_padded(x)
         return xp, mels
 
+    def get_conn_padded_offdiagonal(self, x):
+        self._setup()
+        xp, mels, _ = self._get_conn_padded(x)
+        if not self._nonzero_diagonal:
+            return jnp.zeros(mels.shape[:-1], dtype=mels.dtype), xp, mels
+
+        # the diagonal element is the first one, unless it is below the cutoff.
+        # In that case the last element is padding, because max_conn_size
+        # accounts for the diagonal element.
+        is_diag = jnp.all(xp[..., 0, :] == x, axis=-1)
+        mels_diag = jnp.where(is_diag, mels[..., 0], 0)
+        xp = jnp.where(is_diag[..., None, None], xp[..., 1:, :], xp[..., :-1, :])
+        mels = jnp.where(is_diag[..., None], mels[..., 1:], mels[..., :-1])
+        return mels_diag, xp, mels
+
     def n_conn(self, x):
         _, _, n_conn = self._get_conn_padded(x)
         return n_conn
@@ -20,7 +20,9 @@ import numba
 from netket.errors import concrete_or_error, NumbaOperatorGetConnDuringTracingError
 
 
-from .compile_helpers import pack_internals
+from netket.utils.numba_threads import use_parallel_kernels
+
+from .cache import cached_pack_internals
 from .base import LocalOperatorBase
 
 if TYPE_CHECKING:
@@ -38,7 +40,7 @@ class LocalOperator(LocalOperatorBase):
     def _setup(self, force: bool = False):
         """Analyze the operator strings and precompute arrays for get_conn inference"""
         if force or not self._initialized:
-            data = pack_internals(
+            data = cached_pack_internals(
                 self.hilbert,
                 self._operators_dict,
                 self.constant,
@@ -90,7 +92,12 @@ class LocalOperator(LocalOperatorBase):
             self,
         )
 
-        xp_ids, mels = self._get_conn_flattened_kernel(
+        if use_parallel_kernels():
+            kernel = self._get_conn_flattened_kernel_parallel
+        else:
+            kernel = self._get_conn_flattened_kernel
+
+        xp_ids, mels = kernel(
             x_ids,
             sections,
             self._basis,
@@ -109,7 +116,7 @@ class LocalOperator(LocalOperatorBase):
         return xp, mels
 
     @staticmethod
-    @numba.jit(nopython=True)
+    @numba.jit(nopython=True, cache=True)
     def _get_conn_flattened_kernel(
         x,
         sections,
@@ -219,6 +226,95 @@ class LocalOperator(LocalOperatorBase):
 
         return x_prime, mels
 
+    @staticmethod
+    @numba.jit(nopython=True, parallel=True, cache=True)
+    def _get_conn_flattened_kernel_parallel(
+        x,
+        sections,
+        basis,
+        constant,
+        diag_mels,
+        n_conns,
+        all_mels,
+        all_x_prime,
+        acting_on,
+        acting_size,
+        nonzero_diagonal,
+        pad=False,
+    ):
+        # Multithreaded version of _get_conn_flattened_kernel. The rows of the
+        # batch are split among the threads in two passes: the first counts the
+        # connected elements of every row, from which the offsets of the rows in
+        # the output are computed, and the second fills the output. The result is
+        # identical to the one of the serial kernel.
+        batch_size = x.shape[0]
+        n_sites = x.shape[1]
+        dtype = all_mels.dtype
+
+        constant = constant.item()
+
+        assert sections.shape[0] == batch_size
+
+        n_operators = n_conns.shape[0]
+        # array to store the row index
+        xs_n = np.empty((batch_size, n_operators), dtype=np.intp)
+        n_conn_b = np.empty(batch_size, dtype=np.intp)
+
+        for b in numba.prange(batch_size):
+            conn_b = 1 if nonzero_diagonal else 0
+            for i in range(n_operators):
+                acting_size_i = acting_size[i]
+                xs_n_bi = 0
+                for k in range(acting_size_i):
+                    site = acting_on[i, acting_size_i - k - 1]
+                    xs_n_bi += x[b, site] * basis[i, k]
+                xs_n[b, i] = xs_n_bi
+                conn_b += n_conns[i, xs_n_bi]
+            n_conn_b[b] = conn_b
+
+        if pad and batch_size > 0:
+            n_conn_b[:] = n_conn_b.max()
+
+        tot_conn = 0
+        for b in range(batch_size):
+            tot_conn += n_conn_b[b]
+            sections[b] = tot_conn
+
+        x_prime = np.empty((tot_conn, n_sites), dtype=x.dtype)
+        mels = np.empty(tot_conn, dtype=dtype)
+
+        for b in numba.prange(batch_size):
+            end = sections[b]
+            c = end - n_conn_b[b]
+            c_diag = c
+
+            if nonzero_diagonal:
+                mels[c_diag] = constant
+                x_prime[c_diag, :] = x[b]
+                c += 1
+
+            for i in range(n_operators):
+                if nonzero_diagonal:
+                    mels[c_diag] += diag_mels[i, xs_n[b, i]]
+
+                n_conn_i = n_conns[i, xs_n[b, i]]
+                acting_size_i = acting_size[i]
+                for cc in range(n_conn_i):
+                    mels[c + cc] = all_mels[i, xs_n[b, i], cc]
+                    x_prime[c + cc, :] = x[b]
+                    for k in range(acting_size_i):
+                        x_prime[c + cc, acting_on[i, k]] = all_x_prime[
+                            i, xs_n[b, i], cc, k
+                        ]
+                c += n_conn_i
+
+            # zero-valued matrix elements padding the row
+            for cc in range(c, end):
+                mels[cc] = 0
+                x_prime[cc, :] = x[b]
+
+        return x_prime, mels
+
     def get_conn_filtered(self, x, sections, filters):
         r"""Finds the connected elements of the Operator using only a subset of operators. Starting
         from a given quantum number x, it finds all other quantum numbers x' such
@@ -269,7 +365,7 @@ class LocalOperator(LocalOperatorBase):
         return xp, mels
 
     @staticmethod
-    @numba.jit(nopython=True)
+    @numba.jit(nopython=True, cache=True)
     def _get_conn_filtered_kernel(
         x,
         sections,
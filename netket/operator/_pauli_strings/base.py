@@ -30,6 +30,7 @@ from netket.utils.numbers import dtype as _dtype, is_scalar
 
 from .._abstract_operator import AbstractOperator
 from .._discrete_operator import DiscreteOperator
+from .._discrete_operator_jax import DiscreteJaxOperator, _is_other_jax_operator
 
 valid_pauli_regex = re.compile(r"^[XYZI]+$")
 
@@ -404,6 +405,8 @@ class PauliStringsBase(DiscreteOperator):
         return self.__iadd__(-other)
 
     def __add__(self, other: Union["PauliStringsBase", Number]):
+        if _is_other_jax_operator(self, other, PauliStringsBase):
+            return DiscreteJaxOperator.__add__(self, other)
         op = self.copy(dtype=jnp.promote_types(self.dtype, _dtype(other)))
         op = op.__iadd__(other)
         return op
@@ -437,6 +440,8 @@ class PauliStringsBase(DiscreteOperator):
                 return self.__iadd__(other * self.identity(self.hilbert))
             return self
 
+        if _is_other_jax_operator(self, other, PauliStringsBase):
+            return NotImplemented
         raise NotImplementedError
 
 
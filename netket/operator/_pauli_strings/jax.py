@@ -25,6 +25,7 @@ from netket.hilbert import AbstractHilbert, HomogeneousHilbert
 from netket.errors import concrete_or_error, JaxOperatorSetupDuringTracingError
 from netket.utils.types import DType
 from netket.utils import HashableArray
+from netket.jax._bitpacking import pack_bits, parity
 
 from .._discrete_operator_jax import DiscreteJaxOperator
 
@@ -302,6 +303,152 @@ def _pauli_strings_n_conn_jax(x_flip_masks_all, z_data, x, cutoff=None):
         return jnp.full(x.shape[:-1], max_conn_size, dtype=np.int32)
 
 
+def pack_groups(x_flip_masks_all, z_data):
+    """
+    Rearranges the output of :func:`pack_internals_jax` into numpy arrays with
+    one row per group of strings (flipping the same sites), so that the matrix
+    element of a single group can be computed without touching the others.
+
+    Returns the tuple `(offdiag, weights, z_sign_indices, z_sign_indexmask)`:
+    the indices of the groups flipping at least one site, and the weights, the
+    indices of the sites on which Z is applied and their padding mask, of shapes
+    `(n_groups, max_strings)` and `(n_groups, max_strings, max_z)`.
+    """
+    n_sites = x_flip_masks_all.shape[-1]
+    masks = []
+    weights = []
+    for w, z_sign_mask, z_sign_indices, z_sign_indexmask in zip(*z_data):
+        if z_sign_mask is None:
+            # the padding index -1 does not match any site
+            z_sign_mask = np.asarray(z_sign_indices)[..., None] == np.arange(n_sites)
+            if z_sign_indexmask is not None:
+                z_sign_mask &= np.asarray(z_sign_indexmask)[..., None]
+            z_sign_mask = z_sign_mask.any(axis=-2)
+        masks.append(np.asarray(z_sign_mask, dtype=bool))
+        weights.append(np.asarray(w))
+
+    n_groups = sum(w.shape[0] for w in weights)
+    max_strings = max((w.shape[1] for w in weights), default=0)
+    max_z = max((int(m.sum(axis=-1).max(initial=0)) for m in masks), default=0)
+    dtype = np.result_type(*weights) if weights else np.float64
+
+    group_weights = np.zeros((n_groups, max_strings), dtype=dtype)
+    group_indices = np.zeros((n_groups, max_strings, max_z), dtype=np.int32)
+    group_indexmask = np.zeros((n_groups, max_strings, max_z), dtype=bool)
+    start = 0
+    for w, m in zip(weights, masks):
+        n, l = w.shape
+        # move the sites on which Z is applied to the front
+        idx = np.argsort(~m, axis=-1, kind="stable")[..., :max_z]
+        group_weights[start : start + n, :l] = w
+        group_indices[start : start + n, :l] = idx
+        group_indexmask[start : start + n, :l] = np.take_along_axis(m, idx, axis=-1)
+        start += n
+
+    (offdiag,) = np.nonzero(np.asarray(x_flip_masks_all).any(axis=-1))
+    return (
+        jnp.asarray(offdiag, dtype=np.int32),
+        jnp.asarray(group_weights),
+        jnp.asarray(group_indices),
+        jnp.asarray(group_indexmask),
+    )
+
+
+@jax.jit
+def _pauli_strings_sample_conn_uniform_jax(x_flip_masks_all, groups, key, x, cutoff):
+    # Chooses one of the off-diagonal groups of strings (which flip the same
+    # sites) uniformly, and flips its sites if its matrix element does not
+    # vanish on x, otherwise it proposes x itself. Every group is an involution
+    # whose matrix element vanishes on x if and only if it vanishes on x' (the
+    # operator being hermitian), so this is a symmetric proposal. Only the
+    # strings of the chosen group are evaluated.
+    offdiag, weights, z_sign_indices, z_sign_indexmask = groups
+    batch_shape = x.shape[:-1]
+    if offdiag.shape[0] == 0:
+        return x, jnp.zeros(batch_shape)
+
+    x_flat = x.reshape(-1, x.shape[-1])
+    i = jax.random.randint(key, x_flat.shape[:-1], 0, offdiag.shape[0])
+    k = offdiag[i]
+
+    was_state_1 = jax.vmap(lambda x, idx: x[idx] == 1)(x_flat, z_sign_indices[k])
+    sgn = (1 - 2 * (was_state_1 & z_sign_indexmask[k]).astype(np.int8)).prod(
+        axis=-1, promote_integers=False
+    )
+    mels = jnp.sum(sgn * weights[k], axis=-1)
+    nonzero = jnp.abs(mels) > (cutoff if cutoff is not None else 0)
+
+    x_flip_masks = x_flip_masks_all[k] & nonzero[:, None]
+    x_prime = _ising_conn_states_jax(x_flat, x_flip_masks)
+    return x_prime.reshape(x.shape), jnp.zeros(batch_shape)
+
+
+@jax.jit
+def _pauli_strings_sample_conn_weighted_jax(x_flip_masks_all, z_data, key, x, cutoff):
+    # Samples one of the off-diagonal groups of strings (which flip the same
+    # sites) with probability proportional to the absolute value of its matrix
+    # element, correcting for the different total weight of x and x'. This
+    # requires the matrix elements of all the groups, but not the connected
+    # states.
+    is_offdiag = x_flip_masks_all.any(axis=-1)
+
+    def _weights(x):
+        w = jnp.abs(_pauli_strings_mels_jax(z_data, x))
+        if cutoff is not None:
+            w = jnp.where(w > cutoff, w, 0)
+        return jnp.where(is_offdiag, w, 0)
+
+    w = _weights(x)
+    k = jax.random.categorical(key, jnp.log(w))
+    x_prime = _ising_conn_states_jax(x, x_flip_masks_all[k])
+
+    log_prob_corr = jnp.log(w.sum(axis=-1)) - jnp.log(_weights(x_prime).sum(axis=-1))
+    return x_prime, log_prob_corr
+
+
+def _packed_z_sign_masks(z_data, n_sites):
+    # converts the masks (or indices) of the sites on which Z is applied to
+    # bit-packed masks of shape (n_conn, n_ops, n_words)
+    res = []
+    for w, z_sign_mask, z_sign_indices, z_sign_indexmask in zip(*z_data):
+        if z_sign_mask is None:
+            # one_hot maps the padding index -1 to an empty row
+            z_sign_mask = jax.nn.one_hot(z_sign_indices, n_sites, dtype=jnp.bool_)
+            if z_sign_indexmask is not None:
+                z_sign_mask = z_sign_mask & z_sign_indexmask[..., None]
+            z_sign_mask = z_sign_mask.any(axis=-2)
+        res.append((w, pack_bits(z_sign_mask)))
+    return res
+
+
+@jax.jit
+def _pauli_strings_kernel_packed_jax(x_flip_masks_all, z_data, x, cutoff=None):
+    # same as _pauli_strings_kernel_jax, but acting on bit-packed states:
+    # flipping is a xor with the packed X mask, and the sign picked up by
+    # the Z is the parity of the popcount of the state and the packed Z mask
+    n_sites = x_flip_masks_all.shape[-1]
+    x_flip_masks_all = pack_bits(x_flip_masks_all)
+
+    mels = []
+    for w, z_sign_mask in _packed_z_sign_masks(z_data, n_sites):
+        sgn = 1 - 2 * parity(x[..., None, None, :] & z_sign_mask).astype(np.int8)
+        mels.append(jnp.einsum("...ab,ab->...a", sgn, w))
+    if len(mels) > 0:
+        mels = jnp.concatenate(mels, axis=-1)
+    else:
+        mels = jnp.zeros(x.shape[:-1] + (0,))
+
+    if cutoff is not None:
+        nonzero_mels_mask = jnp.abs(mels) > cutoff
+        mels = jax.lax.select(nonzero_mels_mask, mels, jnp.zeros_like(mels))
+        # only flip if corresponding mel is nonzero
+        x_flip_masks_all = jnp.where(
+            nonzero_mels_mask[..., None], x_flip_masks_all, jnp.uint64(0)
+        )
+    x_prime = x[..., None, :] ^ x_flip_masks_all
+    return x_prime, mels
+
+
 @register_pytree_node_class
 class PauliStringsJax(PauliStringsBase, DiscreteJaxOperator):
     """
@@ -400,6 +547,10 @@ class PauliStringsJax(PauliStringsBase, DiscreteJaxOperator):
             )
             self._x_flip_masks_stacked = x_flip_masks_stacked
             self._z_data = z_data
+            self._groups = pack_groups(x_flip_masks_stacked, z_data)
+            # position of the strings not flipping any site, if any
+            (diag_index,) = np.nonzero(~np.asarray(x_flip_masks_stacked).any(axis=-1))
+            self._diag_index = int(diag_index[0]) if len(diag_index) > 0 else None
             self._initialized = True
 
     def _reset_caches(self):
@@ -429,20 +580,62 @@ class PauliStringsJax(PauliStringsBase, DiscreteJaxOperator):
         xp = self.hilbert.local_indices_to_states(xp_ids, dtype=x.dtype)
         return xp, mels
 
+    def get_conn_padded_offdiagonal(self, x):
+        self._setup()
+        xp, mels = self.get_conn_padded(x)
+        d = self._diag_index
+        if d is None:
+            return jnp.zeros(mels.shape[:-1], dtype=mels.dtype), xp, mels
+        return mels[..., d], jnp.delete(xp, d, axis=-2), jnp.delete(mels, d, axis=-1)
+
+    def get_conn_padded_packed(self, x):
+        self._setup()
+        return _pauli_strings_kernel_packed_jax(
+            self._x_flip_masks_stacked,
+            self._z_data,
+            x,
+            cutoff=self._cutoff,
+        )
+
+    def sample_conn(self, key, x, *, weighted=False):
+        r"""Samples one state :math:`x'` connected to every state :math:`x` in the
+        batch. See :meth:`~netket.operator.DiscreteJaxOperator.sample_conn`.
+
+        If `weighted=False`, one of the groups of strings flipping the same sites
+        is chosen uniformly among those flipping at least one site, and only its
+        matrix element is computed: if it vanishes, :math:`x` itself is proposed.
+        The cost is proportional to the size of the group and does not depend on
+        the number of strings. If `weighted=True`, the matrix elements of all the
+        strings are computed (but not the connected states).
+        """
+        self._setup()
+        x_ids = self.hilbert.states_to_local_indices(x)
+        if weighted:
+            xp_ids, log_prob_corr = _pauli_strings_sample_conn_weighted_jax(
+                self._x_flip_masks_stacked, self._z_data, key, x_ids, self._cutoff
+            )
+        else:
+            xp_ids, log_prob_corr = _pauli_strings_sample_conn_uniform_jax(
+                self._x_flip_masks_stacked, self._groups, key, x_ids, self._cutoff
+            )
+        xp = self.hilbert.local_indices_to_states(xp_ids, dtype=x.dtype)
+        return xp, log_prob_corr
+
     def tree_flatten(self):
         self._setup()
-        data = (self.weights, self._x_flip_masks_stacked, self._z_data)
+        data = (self.weights, self._x_flip_masks_stacked, self._z_data, self._groups)
         metadata = {
             "hilbert": self.hilbert,
             "operators": self._operators_hashable,
             "dtype": self.dtype,
             "mode": self._mode,
+            "diag_index": self._diag_index,
         }
         return data, metadata
 
     @classmethod
     def tree_unflatten(cls, metadata, data):
-        (weights, xm, zd) = data
+        (weights, xm, zd, groups) = data
         hi = metadata["hilbert"]
         operators_hashable = metadata["operators"]
         dtype = metadata["dtype"]
@@ -456,6 +649,8 @@ class PauliStringsJax(PauliStringsBase, DiscreteJaxOperator):
         op._weights = weights
         op._x_flip_masks_stacked = xm
         op._z_data = zd
+        op._groups = groups
+        op._diag_index = metadata["diag_index"]
         op._initialized = True
         return op
 
@@ -0,0 +1,291 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from collections.abc import Iterable
+from numbers import Number
+
+import numpy as np
+
+import jax
+import jax.numpy as jnp
+from jax.tree_util import register_pytree_node_class
+
+from netket.jax import canonicalize_dtypes
+from netket.utils.numbers import is_scalar
+from netket.utils.types import DType, Array
+
+from ._discrete_operator_jax import DiscreteJaxOperator
+
+
+def _flatten_sumoperators(
+    operators: Iterable[DiscreteJaxOperator], coefficients: Array, constant: Number
+):
+    """Flatten sumoperators inside of operators."""
+    new_operators = []
+    new_coeffs = []
+    for op, c in zip(operators, coefficients):
+        if isinstance(op, SumOperatorJax):
+            new_operators.extend(op.operators)
+            new_coeffs.extend(c * op.coefficients)
+            constant = constant + c * op.constant
+        else:
+            new_operators.append(op)
+            new_coeffs.append(c)
+    return new_operators, new_coeffs, constant
+
+
+def _merge_duplicate_states(x, xp, mels):
+    # Sums the matrix elements of identical connected states of a single state x.
+    # Every distinct state is kept once, while the duplicates get a zero matrix
+    # element and are replaced by x, so that the output keeps a static shape.
+    perm = jnp.lexsort(list(xp.T)[::-1])
+    xp = xp[perm]
+    mels = mels[perm]
+    is_new = jnp.concatenate(
+        [jnp.ones((1,), dtype=bool), jnp.any(xp[1:] != xp[:-1], axis=-1)]
+    )
+    group = jnp.cumsum(is_new) - 1
+    mels = jnp.zeros_like(mels).at[group].add(mels)[group]
+    mels = jnp.where(is_new, mels, 0)
+    xp = jnp.where(is_new[:, None], xp, x)
+    return xp, mels
+
+
+@register_pytree_node_class
+class SumOperatorJax(DiscreteJaxOperator):
+    r"""
+    Sum of several jax-compatible discrete operators, possibly of different types.
+
+    The connected elements of all the terms are computed in a single jittable
+    call, and concatenated in one padded output. The connected states appearing
+    in several terms, such as the diagonal element or the states reached by a
+    Pauli string and a local operator acting on the same sites, are merged by
+    summing their matrix elements. The merged states have a zero matrix element
+    and are replaced by the starting state :math:`x`, so that the padded output
+    contains every distinct connected state only once.
+
+    The merged states are found by sorting the connected states of every
+    :math:`x`, at a cost :math:`O(K\log K \cdot N)`, where :math:`K` is the
+    number of connected states of all the terms. When computing expectation
+    values with a :class:`~netket.vqs.MCState`, the model is only evaluated on
+    the connected states with a non-zero matrix element, so neither the merged
+    states nor the padding of the terms are evaluated.
+
+    Adding jax operators of different types, for example a
+    :class:`~netket.operator.PauliStringsJax` and a
+    :class:`~netket.operator.LocalOperatorJax`, returns this operator.
+
+    .. warning::
+
+        This class is a Pytree, so it **can** be used inside of jax-transformed
+        functions like `jax.grad` or `jax.jit`.
+    """
+
+    def __init__(
+        self,
+        *operators: DiscreteJaxOperator,
+        coefficients: float | Iterable[float] = 1.0,
+        constant: Number = 0,
+        dtype: DType | None = None,
+    ):
+        r"""
+        Constructs the sum of several jax operators.
+
+        Args:
+            operators: The jax operators to sum, acting on the same hilbert space.
+            coefficients: A coefficient for each operator, or a single coefficient
+                multiplying all of them (default: 1).
+            constant: A constant added to the diagonal (default: 0).
+            dtype: Data type of the matrix elements.
+        """
+        if len(operators) == 0:
+            raise ValueError("At least one operator must be specified.")
+        if not all(isinstance(op, DiscreteJaxOperator) for op in operators):
+            raise TypeError(
+                "SumOperatorJax can only sum DiscreteJaxOperators, but got "
+                f"{[type(op) for op in operators]}."
+            )
+
+        hi_spaces = [op.hilbert for op in operators]
+        if not all(hi == hi_spaces[0] for hi in hi_spaces):
+            raise ValueError(f"Can only add identical hilbert spaces, got {hi_spaces}.")
+
+        if is_scalar(coefficients):
+            coefficients = [coefficients for _ in operators]
+
+        if len(operators) != len(coefficients):
+            raise ValueError("Each operator needs a coefficient.")
+
+        operators, coefficients, constant = _flatten_sumoperators(
+            operators, coefficients, constant
+        )
+
+        dtype = canonicalize_dtypes(
+            float, *operators, *coefficients, constant, dtype=dtype
+        )
+
+        super().__init__(hi_spaces[0])
+        self._operators = tuple(operators)
+        self._coefficients = jnp.asarray(coefficients, dtype=dtype)
+        self._constant = jnp.asarray(constant, dtype=dtype)
+        self._dtype = dtype
+        self._is_hermitian = (
+            all(op.is_hermitian for op in operators)
+            and bool(np.all(np.isreal(np.asarray(coefficients))))
+            and bool(np.isreal(np.asarray(constant)))
+        )
+
+        # the static number of connected elements of every term, without the
+        # diagonal element that is stored only once.
+        x = jax.ShapeDtypeStruct((1, self.hilbert.size), jnp.result_type(float))
+        self._max_conn_size = 1 + sum(
+            jax.eval_shape(op.get_conn_padded_offdiagonal, x)[2].shape[-1]
+            for op in operators
+        )
+
+    @property
+    def operators(self) -> tuple[DiscreteJaxOperator, ...]:
+        """The list of all operators in the terms of this sum. Every
+        operator is summed with a corresponding coefficient
+        """
+        return self._operators
+
+    @property
+    def coefficients(self) -> Array:
+        return self._coefficients
+
+    @property
+    def constant(self) -> Array:
+        """The constant added to the diagonal."""
+        return self._constant
+
+    @property
+    def dtype(self) -> DType:
+        return self._dtype
+
+    @property
+    def is_hermitian(self) -> bool:
+        return self._is_hermitian
+
+    @property
+    def max_conn_size(self) -> int:
+        """The maximum number of non zero ⟨x|O|x'⟩ for every x."""
+        return self._max_conn_size
+
+    def tree_flatten(self):
+        data = (self._operators, self._coefficients, self._constant)
+        metadata = {
+            "hilbert": self.hilbert,
+            "dtype": self.dtype,
+            "is_hermitian": self._is_hermitian,
+            "max_conn_size": self._max_conn_size,
+        }
+        return data, metadata
+
+    @classmethod
+    def tree_unflatten(cls, metadata, data):
+        # the leaves might not be arrays, so the constructor is not called.
+        op = cls.__new__(cls)
+        DiscreteJaxOperator.__init__(op, metadata["hilbert"])
+        op._operators, op._coefficients, op._constant = data
+        op._dtype = metadata["dtype"]
+        op._is_hermitian = metadata["is_hermitian"]
+        op._max_conn_size = metadata["max_conn_size"]
+        return op
+
+    def _get_conn_padded_terms(self, x):
+        # diagonal and concatenated off-diagonal elements of all the terms,
+        # without merging the duplicates.
+        mels_diag = jnp.full(x.shape[:-1], self.constant, dtype=self.dtype)
+        xps, mels = [], []
+        for c, op in zip(self.coefficients, self.operators):
+            op_mels_diag, op_xp, op_mels = op.get_conn_padded_offdiagonal(x)
+            mels_diag = mels_diag + (c * op_mels_diag).astype(self.dtype)
+            xps.append(op_xp.astype(x.dtype))
+            mels.append((c * op_mels).astype(self.dtype))
+        return mels_diag, jnp.concatenate(xps, axis=-2), jnp.concatenate(mels, -1)
+
+    def _merge_duplicates(self, x, xp, mels):
+        N = x.shape[-1]
+        batch_shape = x.shape[:-1]
+        xp, mels = jax.vmap(_merge_duplicate_states)(
+            x.reshape(-1, N),
+            xp.reshape(-1, *xp.shape[-2:]),
+            mels.reshape(-1, mels.shape[-1]),
+        )
+        return xp.reshape(*batch_shape, *xp.shape[-2:]), mels.reshape(
+            *batch_shape, -1
+        )
+
+    @jax.jit
+    def get_conn_padded(self, x):
+        mels_diag, xp, mels = self._get_conn_padded_terms(x)
+        xp = jnp.concatenate([x[..., None, :], xp], axis=-2)
+        mels = jnp.concatenate([mels_diag[..., None], mels], axis=-1)
+        return self._merge_duplicates(x, xp, mels)
+
+    @jax.jit
+    def get_conn_padded_offdiagonal(self, x):
+        mels_diag, xp, mels = self._get_conn_padded_terms(x)
+        xp, mels = self._merge_duplicates(x, xp, mels)
+        return mels_diag, xp, mels
+
+    def __add__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            return SumOperatorJax(self, other)
+        if is_scalar(other):
+            return SumOperatorJax(
+                *self.operators,
+                coefficients=self.coefficients,
+                constant=self.constant + other,
+            )
+        return NotImplemented
+
+    def __radd__(self, other):
+        if isinstance(other, DiscreteJaxOperator):
+            return SumOperatorJax(other, self)
+        if is_scalar(other):
+            return self + other
+        return NotImplemented
+
+    def __mul__(self, other):
+        if is_scalar(other):
+            return SumOperatorJax(
+                *self.operators,
+                coefficients=other * self.coefficients,
+                constant=other * self.constant,
+            )
+        return NotImplemented
+
+    def __rmul__(self, other):
+        return self.__mul__(other)
+
+    def __neg__(self):
+        return -1 * self
+
+    def __sub__(self, other):
+        if isinstance(other, DiscreteJaxOperator) or is_scalar(other):
+            return self + (-other)
+        return NotImplemented
+
+    def __rsub__(self, other):
+        if isinstance(other, DiscreteJaxOperator) or is_scalar(other):
+            return other + (-self)
+        return NotImplemented
+
+    def __repr__(self):
+        return (
+            f"SumOperatorJax(operators={self.operators}, "
+            f"coefficients={self.coefficients}, constant={self.constant})"
+        )
@@ -74,7 +74,21 @@ def QGTOnTheFly(
         samples = vstate.samples
         pdf = None
 
-    if chunk_size is None:
+    if chunk_size is None and getattr(vstate, "chunk_size_auto", False):
+        chunk_size = vstate._autotuned_chunk_size(
+            ("QGTOnTheFly",),
+            lambda vs, c: QGTOnTheFly_DefaultConstructor(
+                vs._apply_fun,
+                vs.parameters,
+                vs.model_state,
+                vs.samples,
+                chunk_size=c,
+                holomorphic=holomorphic,
+                **kwargs,
+            )
+            @ vs.parameters,
+        )
+    elif chunk_size is None:
         chunk_size = getattr(vstate, "chunk_size", None)
 
     return QGTOnTheFly_DefaultConstructor(
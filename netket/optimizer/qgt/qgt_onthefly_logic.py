@@ -102,7 +102,7 @@ def _O_jvp(forward_fn, params, samples, v, chunk_size):
         _, res = jax.jvp(lambda p: forward_fn(p, samples), (params,), (v,))
         return res
 
-    samples, unchunk_fn = chunk(samples, chunk_size)
+    samples, unchunk_fn = chunk(samples, chunk_size, pad_mode="edge")
     res = __O_jvp(forward_fn, params, samples, v)
     return unchunk_fn(res)
 
@@ -119,8 +119,9 @@ def _O_vjp(forward_fn, params, samples, w, chunk_size):
         res, _ = vjp_fun(w)
         return res
 
-    samples, _ = chunk(samples, chunk_size)
-    w, _ = chunk(w, chunk_size)
+    # padding elements have zero weight
+    samples, _ = chunk(samples, chunk_size, pad_mode="edge")
+    w, _ = chunk(w, chunk_size, pad_mode="constant")
     res = __O_vjp(forward_fn, params, samples, w)
     return res
 
@@ -22,12 +22,14 @@ from .exact import ExactSampler
 from .metropolis import (
     MetropolisSampler,
     MetropolisLocal,
+    MetropolisHeatBath,
     MetropolisExchange,
     MetropolisRule,
     MetropolisSamplerState,
     MetropolisHamiltonian,
     MetropolisGaussian,
     MetropolisAdjustedLangevin,
+    MetropolisHMC,
     MetropolisFermionHop,
 )
 
@@ -38,6 +40,11 @@ from .parallel_tempering import (
     ParallelTemperingHamiltonian,
 )
 
+from .population_annealing import (
+    PopulationAnnealingSampler,
+    PopulationAnnealingSamplerState,
+)
+
 from .metropolis_numpy import (
     MetropolisSamplerNumpy,
     MetropolisLocalNumpy,
@@ -46,6 +53,7 @@ from .metropolis_numpy import (
 )
 
 from .autoreg import ARDirectSampler
+from .mps_direct import MPSDirectSampler, MPSDirectSamplerState
 
 from . import rules
 
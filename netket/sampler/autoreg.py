@@ -22,15 +22,29 @@ from netket import jax as nkjax
 from netket import config
 from netket.hilbert import DiscreteHilbert
 from netket.sampler import Sampler, SamplerState
-from netket.utils.types import PRNGKeyT, DType
+from netket.utils import struct
+from netket.utils.types import PRNGKeyT, DType, Array
 
 
 class ARDirectSamplerState(SamplerState):
     key: PRNGKeyT
     """state of the random number generator."""
 
-    def __init__(self, key):
+    unique_σ: Array | None = None
+    """The distinct samples generated by the last sampling, padded by repeating
+    the first distinct sample. Only set if the sampler has `unique_samples=True`."""
+    counts: Array | None = None
+    """The number of occurrences of every sample in `unique_σ` (0 for padding).
+    Only set if the sampler has `unique_samples=True`."""
+    n_unique: Array | None = None
+    """The number of distinct samples in `unique_σ`. Only set if the sampler has
+    `unique_samples=True`."""
+
+    def __init__(self, key, unique_σ=None, counts=None, n_unique=None):
         self.key = key
+        self.unique_σ = unique_σ
+        self.counts = counts
+        self.n_unique = n_unique
         super().__init__()
 
 
@@ -49,13 +63,32 @@ class ARDirectSampler(Sampler):
 
     NetKet implements some autoregressive networks that can be used together with this
     sampler.
+
+    With `unique_samples=True`, the samples are generated as a tree: at every site
+    the conditionals are evaluated only once for every distinct partial
+    configuration (prefix) among the samples, carrying along the cache of the fast
+    autoregressive networks (see :class:`~netket.models.FastARNNSequential`). The
+    distinct samples and their number of occurrences are stored in the sampler
+    state, and :class:`~netket.vqs.MCState` uses them to compute expectation values
+    and gradients evaluating the local estimators only once for every distinct
+    sample. This is useful for peaked distributions, where most samples are
+    duplicates.
     """
 
+    unique_samples: bool = struct.field(pytree_node=False, default=False)
+    """Whether the samples are generated as a tree of distinct prefixes."""
+    unique_chunk_size: int | None = struct.field(pytree_node=False, default=None)
+    """Number of distinct prefixes whose conditionals are evaluated at once, or
+    None to use an eighth of the number of samples."""
+
     def __init__(
         self,
         hilbert: DiscreteHilbert,
         machine_pow: None = None,
         dtype: DType = None,
+        *,
+        unique_samples: bool = False,
+        unique_chunk_size: int | None = None,
     ):
         """
         Construct an autoregressive direct sampler.
@@ -63,6 +96,19 @@ class ARDirectSampler(Sampler):
         Args:
             hilbert: The Hilbert space to sample.
             dtype: The dtype of the states sampled (default = np.float64).
+            unique_samples: If True, the conditionals are evaluated only once for
+                every distinct prefix, and the distinct samples and their number
+                of occurrences are stored in the sampler state (default: False).
+                The samples returned are the same as with `unique_samples=False`.
+            unique_chunk_size: The number of distinct prefixes whose conditionals
+                are evaluated at once when `unique_samples=True`. Only the chunks
+                containing distinct prefixes are evaluated, so the conditionals are
+                evaluated on fewer configurations than the samples only if there
+                are fewer distinct prefixes than the number of samples minus one
+                chunk. Smaller chunks give a larger saving for peaked distributions,
+                but evaluate the model in more sequential calls, so this should
+                be tuned for the model and the hardware. If None (default), an
+                eighth of the number of samples is used.
 
         Note:
             `ARDirectSampler.machine_pow` has no effect. Please set the model's `machine_pow` instead.
@@ -80,9 +126,18 @@ class ARDirectSampler(Sampler):
                 "touch with us. We are interested!)"
             )
 
+        if unique_samples and config.netket_experimental_sharding:
+            raise NotImplementedError(
+                "ARDirectSampler does not support `unique_samples=True` with sharding."
+            )
+        if unique_chunk_size is not None and unique_chunk_size < 1:
+            raise ValueError("unique_chunk_size must be a positive integer.")
+
         super().__init__(hilbert, machine_pow=2, dtype=dtype)
         # ensure machine_pow is a float, as it can be sometimes used around...
         self.machine_pow = float(self.machine_pow)
+        self.unique_samples = unique_samples
+        self.unique_chunk_size = unique_chunk_size
 
     @property
     def is_exact(sampler):
@@ -107,6 +162,9 @@ class ARDirectSampler(Sampler):
 
     @partial(jax.jit, static_argnums=(1, 4))
     def _sample_chain(sampler, model, variables, state, chain_length):
+        if sampler.unique_samples:
+            return sampler._sample_chain_unique(model, variables, state, chain_length)
+
         if "cache" in variables:
             variables, _ = flax.core.pop(variables, "cache")
         variables_no_cache = variables
@@ -165,3 +223,119 @@ class ARDirectSampler(Sampler):
 
         new_state = state.replace(key=new_key)
         return σ, new_state
+
+    def _sample_chain_unique(sampler, model, variables, state, chain_length):
+        if "cache" in variables:
+            variables, _ = flax.core.pop(variables, "cache")
+        variables_no_cache = variables
+
+        n_samples = sampler.n_batches * chain_length
+        if sampler.unique_chunk_size is None:
+            chunk_size = max(n_samples // 8, 1)
+        else:
+            chunk_size = min(sampler.unique_chunk_size, n_samples)
+        # size of the buffer of distinct prefixes
+        n_buffer = -(-n_samples // chunk_size) * chunk_size
+        local_states = jnp.asarray(sampler.hilbert.local_states, dtype=sampler.dtype)
+        n_local = local_states.shape[0]
+
+        def conditionals(prefixes, cache, index, n_groups):
+            # Evaluates the conditionals of the first `n_groups` prefixes, only in
+            # the chunks that contain some of them.
+            def chunk_body(i, carry):
+                p, cache = carry
+                start = i * chunk_size
+                x = jax.lax.dynamic_slice_in_dim(prefixes, start, chunk_size)
+                if cache:
+                    cache_i = jax.tree_util.tree_map(
+                        lambda c: jax.lax.dynamic_slice_in_dim(c, start, chunk_size),
+                        cache,
+                    )
+                    variables = {**variables_no_cache, "cache": cache_i}
+                else:
+                    variables = variables_no_cache
+                p_i, mutables = model.apply(
+                    variables, x, index, method=model.conditional, mutable=["cache"]
+                )
+                p = jax.lax.dynamic_update_slice_in_dim(
+                    p, p_i.astype(p.dtype), start, axis=0
+                )
+                cache_i = mutables.get("cache")
+                if cache:
+                    cache = jax.tree_util.tree_map(
+                        lambda c, c_i: jax.lax.dynamic_update_slice_in_dim(
+                            c, c_i, start, axis=0
+                        ),
+                        cache,
+                        cache_i,
+                    )
+                return p, cache
+
+            n_chunks = (n_groups + chunk_size - 1) // chunk_size
+            p = jnp.zeros((n_buffer, n_local))
+            return jax.lax.fori_loop(0, n_chunks, chunk_body, (p, cache))
+
+        def scan_fun(carry, index):
+            prefixes, cache, group, n_groups, key = carry
+            new_key, key = jax.random.split(key)
+
+            p, cache = conditionals(prefixes, cache, index, n_groups)
+
+            # every sample draws its value from the conditional of its prefix
+            choice = nkjax.batch_choice(key, jnp.arange(n_local), p[group])
+
+            # the new prefixes are the distinct pairs (prefix, value)
+            label = group * n_local + choice
+            perm = jnp.argsort(label)
+            label_sorted = label[perm]
+            is_new = jnp.concatenate(
+                [jnp.ones((1,), dtype=bool), label_sorted[1:] != label_sorted[:-1]]
+            )
+            new_group_sorted = jnp.cumsum(is_new) - 1
+            group = jnp.zeros_like(group).at[perm].set(new_group_sorted)
+            n_groups = new_group_sorted[-1] + 1
+
+            # unused entries of the buffer are copies of the first prefix, with the
+            # current site set to the first local state
+            parent_label = jnp.zeros((n_buffer,), dtype=label.dtype)
+            parent_label = parent_label.at[
+                jnp.where(is_new, new_group_sorted, n_buffer)
+            ].set(label_sorted, mode="drop")
+            parent, value = jnp.divmod(parent_label, n_local)
+            prefixes = prefixes[parent].at[:, index].set(local_states[value])
+            if cache:
+                cache = jax.tree_util.tree_map(lambda c: c[parent], cache)
+
+            return (prefixes, cache, group, n_groups, new_key), None
+
+        new_key, key_init, key_scan = jax.random.split(state.key, 3)
+
+        prefixes = jnp.zeros((n_buffer, sampler.hilbert.size), dtype=sampler.dtype)
+        cache = sampler._init_cache(model, prefixes, key_init)
+        if cache:
+            variables = {**variables_no_cache, "cache": cache}
+        else:
+            variables = variables_no_cache
+
+        # all samples start from the same empty prefix
+        group = jnp.zeros((n_samples,), dtype=int)
+        n_groups = jnp.ones((), dtype=int)
+
+        indices = jnp.arange(sampler.hilbert.size)
+        indices = model.apply(variables, indices, method=model.reorder)
+        (prefixes, _, group, n_groups, _), _ = jax.lax.scan(
+            scan_fun, (prefixes, cache, group, n_groups, key_scan), indices
+        )
+
+        counts = jnp.zeros((n_buffer,), dtype=jnp.int32).at[group].add(1)
+        # the padding, which might not be a sample, is replaced by the first sample
+        is_unique = jnp.arange(n_buffer) < n_groups
+        prefixes = jnp.where(is_unique[:, None], prefixes, prefixes[0])
+        σ = prefixes[group].reshape(
+            (sampler.n_batches, chain_length, sampler.hilbert.size)
+        )
+
+        new_state = state.replace(
+            key=new_key, unique_σ=prefixes, counts=counts, n_unique=n_groups
+        )
+        return σ, new_state
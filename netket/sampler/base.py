@@ -175,10 +175,15 @@ class Sampler(struct.Pytree):
 
         Usage of this flag is required to support both MPI and sharding.
 
+        Inside of a function mapped over the devices with
+        :func:`~netket.jax.sharding.sharding_decorator` or, for Metropolis samplers,
+        inside of the sweep, every device only sees its own chains, so this returns
+        :attr:`~Sampler.n_chains_per_rank`.
+
         Samplers may override this to have a larger batch size, for example to
         propagate multiple replicas (in the case of parallel tempering).
         """
-        if config.netket_experimental_sharding:
+        if config.netket_experimental_sharding and sharding.SHARD_MAP_STACK_LEVEL == 0:
             return self.n_chains
         else:
             return self.n_chains_per_rank
@@ -22,16 +22,19 @@ import numpy as np
 import jax
 from flax import linen as nn
 from jax import numpy as jnp
+from jax.experimental.shard_map import shard_map
+from jax.sharding import Mesh, PartitionSpec as P
 
 from netket.hilbert import AbstractHilbert, ContinuousHilbert, SpinOrbitalFermions
 
-from netket.utils import mpi, wrap_afun
+from netket.utils import config, mpi, wrap_afun
 from netket.utils.types import PyTree, DType
 
 from netket.utils.deprecation import warn_deprecation
 from netket.utils import struct
 
 from netket.jax.sharding import (
+    _increase_SHARD_MAP_STACK_LEVEL,
     device_count,
     shard_along_axis,
 )
@@ -74,6 +77,9 @@ class MetropolisSamplerState(SamplerState):
         )
     )
     """Number of accepted transitions among the chains in this process since the last reset."""
+    fast_update_cache: PyTree | None = struct.field(serialize=False, default=None)
+    """Optional cache of intermediate quantities of the model used to update the
+    log-amplitudes incrementally. Only used if the sampler has `use_fast_updates=True`."""
 
     def __init__(
         self,
@@ -81,10 +87,12 @@ class MetropolisSamplerState(SamplerState):
         rng: jnp.ndarray,
         rule_state: Any | None,
         log_prob: jnp.ndarray | None = None,
+        fast_update_cache: PyTree | None = None,
     ):
         self.σ = σ
         self.rng = rng
         self.rule_state = rule_state
+        self.fast_update_cache = fast_update_cache
 
         if log_prob is None:
             log_prob = jnp.full(self.σ.shape[:-1], -jnp.inf, dtype=float)
@@ -179,6 +187,36 @@ def _assert_good_log_prob_shape(log_prob, n_chains_per_rank, machine):
         )
 
 
+def _check_fast_update_machine(machine):
+    if not (
+        hasattr(machine, "init_fast_update") and hasattr(machine, "update_fast_update")
+    ):
+        raise TypeError(
+            dedent(
+                f"""
+
+            The model {machine} does not support fast updates, but the sampler
+            was constructed with `use_fast_updates=True`.
+
+            To support fast updates, the model must define the methods
+            `init_fast_update` and `update_fast_update`. See the documentation
+            of `netket.sampler.MetropolisSampler` for the expected signatures.
+
+            """
+            )
+        )
+
+
+def _changed_sites(σ, σp, n_sites):
+    # Indices of the (at most n_sites) sites that differ among σ and σp.
+    # Missing entries are padded with σ.shape[-1], which is out of bounds.
+    def _changed_sites_single(σ, σp):
+        (idx,) = jnp.nonzero(σ != σp, size=n_sites, fill_value=σ.shape[-1])
+        return idx
+
+    return jax.vmap(_changed_sites_single)(σ, σp)
+
+
 def _round_n_chains_to_next_multiple(
     n_chains, n_chains_per_whatever, n_whatever, whatever_str
 ):
@@ -225,6 +263,38 @@ class MetropolisSampler(Sampler):
     and :math:`L(s,s^\prime)` is a suitable correcting factor computed by the transition kernel.
 
     The dtype of the sampled states can be chosen.
+
+    If the transition rule only modifies a bounded number of sites (see
+    :attr:`~netket.sampler.rules.MetropolisRule.max_changed_sites`) and the model
+    supports it, the log-amplitude of the proposed states can be computed
+    incrementally from a cache of intermediate quantities instead of evaluating the
+    model from scratch by setting `use_fast_updates=True`.
+    To support fast updates, a Flax model must expose the two methods
+
+    .. code-block:: python
+
+        def init_fast_update(self, σ):
+            # returns (log_psi(σ), cache), where all leaves of cache
+            # have a leading batch dimension.
+            ...
+
+        def update_fast_update(self, cache, σ, σp, sites):
+            # returns (log_psi(σp), new_cache), where `sites` is an integer
+            # matrix of shape (batch, max_changed_sites) with the indices of the
+            # sites that differ among σ and σp. Entries equal to `σ.shape[-1]`
+            # are padding and must be ignored.
+            ...
+
+    See :class:`netket.models.RBM` and :class:`netket.models.Jastrow` for
+    examples.
+
+    For Hilbert spaces with local dimension 2, the state of the chains and the
+    returned samples can be stored in the bit-packed representation of
+    :meth:`~netket.hilbert.DiscreteHilbert.states_to_packed` by setting
+    `packed_states=True`, reducing their memory footprint by a factor of up to 64.
+    The chains are unpacked only while they are evolved, and
+    :class:`~netket.vqs.MCState` unpacks the samples when they are accessed, so
+    that local estimators and gradients are computed on unpacked states.
     """
 
     rule: MetropolisRule = None
@@ -238,6 +308,11 @@ class MetropolisSampler(Sampler):
     """Chunk size for evaluating wave functions."""
     reset_chains: bool = struct.field(pytree_node=False, default=False)
     """If True, resets the chain state when `reset` is called on every new sampling."""
+    use_fast_updates: bool = struct.field(pytree_node=False, default=False)
+    """If True, the log-amplitudes of the proposed states are computed incrementally
+    using the fast-update protocol of the model."""
+    packed_states: bool = struct.field(pytree_node=False, default=False)
+    """If True, the state of the chains and the samples are stored bit-packed."""
 
     def __init__(
         self,
@@ -252,6 +327,8 @@ class MetropolisSampler(Sampler):
         chunk_size: int | None = None,
         machine_pow: int = 2,
         dtype: DType = None,
+        use_fast_updates: bool = False,
+        packed_states: bool = False,
     ):
         """
         Constructs a Metropolis Sampler.
@@ -278,6 +355,15 @@ class MetropolisSampler(Sampler):
             machine_pow: The power to which the machine should be exponentiated to generate
                 the pdf (default = 2).
             dtype: The dtype of the states sampled (default = np.float64).
+            use_fast_updates: If True, computes the log-amplitude of the proposed states
+                by incrementally updating a cache provided by the model, instead of
+                evaluating the model from scratch (default = False). Requires a rule
+                with a finite `max_changed_sites` and a model implementing
+                `init_fast_update` and `update_fast_update`.
+            packed_states: If True, stores the state of the chains and the returned
+                samples in the bit-packed `uint64` representation of
+                :meth:`~netket.hilbert.DiscreteHilbert.states_to_packed`
+                (default = False). Requires a Hilbert space with local dimension 2.
         """
 
         # Validate the inputs
@@ -290,6 +376,13 @@ class MetropolisSampler(Sampler):
         if not isinstance(reset_chains, bool):
             raise TypeError("reset_chains must be a boolean.")
 
+        if use_fast_updates and rule.max_changed_sites is None:
+            raise ValueError(
+                f"The rule {rule} does not declare the maximum number of sites "
+                "changed by a transition (`max_changed_sites`), so it cannot be "
+                "used with `use_fast_updates=True`."
+            )
+
         if n_sweeps is not None:
             warn_deprecation(
                 "Specifying `n_sweeps` when constructing sampler is deprecated. Please use `sweep_size` instead."
@@ -298,6 +391,18 @@ class MetropolisSampler(Sampler):
                 raise ValueError("Cannot specify both `sweep_size` and `n_sweeps`")
             sweep_size = n_sweeps
 
+        if packed_states:
+            # the chains are unpacked and packed around the sweeps by `_sample_next`
+            if type(self)._sample_next is not MetropolisSampler._sample_next:
+                raise NotImplementedError(
+                    f"{type(self).__name__} does not support `packed_states=True`."
+                )
+            if not getattr(hilbert, "supports_packed_states", False):
+                raise ValueError(
+                    f"The Hilbert space {hilbert} does not support the bit-packed "
+                    "representation of states, which requires local dimension 2."
+                )
+
         if sweep_size is None:
             sweep_size = hilbert.size
 
@@ -330,6 +435,8 @@ class MetropolisSampler(Sampler):
         self.reset_chains = reset_chains
         self.rule = rule
         self.sweep_size = sweep_size
+        self.use_fast_updates = use_fast_updates
+        self.packed_states = packed_states
 
     @property
     def n_sweeps(self):
@@ -338,6 +445,18 @@ class MetropolisSampler(Sampler):
         )
         return self.sweep_size
 
+    def _pack_states(sampler, σ):
+        # Converts states to the representation stored in the sampler state.
+        if sampler.packed_states:
+            return sampler.hilbert.states_to_packed(σ)
+        return σ
+
+    def _unpack_states(sampler, σ):
+        # Inverse of `_pack_states`, returning states of dtype `sampler.dtype`.
+        if sampler.packed_states:
+            return sampler.hilbert.packed_to_states(σ, dtype=sampler.dtype)
+        return σ
+
     def sample_next(
         sampler,
         machine: Callable | nn.Module,
@@ -380,8 +499,23 @@ class MetropolisSampler(Sampler):
         )
         log_prob = shard_along_axis(log_prob, axis=0)
 
+        if sampler.use_fast_updates:
+            _check_fast_update_machine(machine)
+            _, cache_shape = jax.eval_shape(
+                partial(machine.apply, method="init_fast_update"), parameters, σ
+            )
+            fast_update_cache = jax.tree_util.tree_map(
+                lambda x: jnp.zeros(x.shape, dtype=x.dtype), cache_shape
+            )
+        else:
+            fast_update_cache = None
+
         state = MetropolisSamplerState(
-            σ=σ, rng=key_state, rule_state=rule_state, log_prob=log_prob
+            σ=σ,
+            rng=key_state,
+            rule_state=rule_state,
+            log_prob=log_prob,
+            fast_update_cache=fast_update_cache,
         )
         # If we don't reset the chain at every sampling iteration, then reset it
         # now.
@@ -396,7 +530,7 @@ class MetropolisSampler(Sampler):
             )
             σ = shard_along_axis(σ, axis=0)
             state = state.replace(σ=σ, rng=key_state)
-        return state
+        return state.replace(σ=sampler._pack_states(state.σ))
 
     @partial(jax.jit, static_argnums=1)
     def _reset(sampler, machine, parameters, state):
@@ -413,19 +547,33 @@ class MetropolisSampler(Sampler):
             )
             σ = shard_along_axis(σ, axis=0)
         else:
-            σ = state.σ
+            σ = sampler._unpack_states(state.σ)
 
         # Recompute the log_probability of the current samples
-        apply_machine = apply_chunked(
-            machine.apply, in_axes=(None, 0), chunk_size=sampler.chunk_size
-        )
-        log_prob_σ = sampler.machine_pow * apply_machine(parameters, σ).real
+        if sampler.use_fast_updates:
+            # Rebuild the cache from scratch, which also discards the numerical
+            # error accumulated by the incremental updates.
+            _check_fast_update_machine(machine)
+            init_machine = apply_chunked(
+                partial(machine.apply, method="init_fast_update"),
+                in_axes=(None, 0),
+                chunk_size=sampler.chunk_size,
+            )
+            log_val_σ, fast_update_cache = init_machine(parameters, σ)
+        else:
+            apply_machine = apply_chunked(
+                machine.apply, in_axes=(None, 0), chunk_size=sampler.chunk_size
+            )
+            log_val_σ = apply_machine(parameters, σ)
+            fast_update_cache = None
+        log_prob_σ = sampler.machine_pow * log_val_σ.real
 
         rule_state = sampler.rule.reset(sampler, machine, parameters, state)
 
         return state.replace(
-            σ=σ,
+            σ=sampler._pack_states(σ),
             log_prob=log_prob_σ,
+            fast_update_cache=fast_update_cache,
             rng=rng,
             rule_state=rule_state,
             n_steps_proc=jnp.zeros_like(state.n_steps_proc),
@@ -438,60 +586,34 @@ class MetropolisSampler(Sampler):
 
         If you subclass `MetropolisSampler`, you should override this and not `sample_next`
         itself, because `sample_next` contains some common logic.
-        """
-        apply_machine = apply_chunked(
-            machine.apply, in_axes=(None, 0), chunk_size=sampler.chunk_size
-        )
-
-        def loop_body(i, s):
-            # 1 to propagate for next iteration, 1 for uniform rng and n_chains for transition kernel
-            s["key"], key1, key2 = jax.random.split(s["key"], 3)
-
-            σp, log_prob_correction = sampler.rule.transition(
-                sampler, machine, parameters, state, key1, s["σ"]
-            )
-            _assert_good_sample_shape(
-                σp,
-                (sampler.n_batches, sampler.hilbert.size),
-                sampler.dtype,
-                f"{sampler.rule}.transition",
-            )
-            proposal_log_prob = sampler.machine_pow * apply_machine(parameters, σp).real
-            _assert_good_log_prob_shape(proposal_log_prob, sampler.n_batches, machine)
-
-            uniform = jax.random.uniform(key2, shape=(sampler.n_batches,))
-            if log_prob_correction is not None:
-                do_accept = uniform < jnp.exp(
-                    proposal_log_prob - s["log_prob"] + log_prob_correction
-                )
-            else:
-                do_accept = uniform < jnp.exp(proposal_log_prob - s["log_prob"])
-
-            # do_accept must match ndim of proposal and state (which is 2)
-            s["σ"] = jnp.where(do_accept.reshape(-1, 1), σp, s["σ"])
-            s["accepted"] += do_accept
-
-            s["log_prob"] = jax.numpy.where(
-                do_accept.reshape(-1), proposal_log_prob, s["log_prob"]
-            )
 
-            return s
+        When running with the experimental sharding mode on several devices, the
+        sweep is performed inside of :func:`jax.experimental.shard_map.shard_map`,
+        such that every device evolves its own chains and no communication among
+        devices takes place inside of the loop.
 
+        With `packed_states=True` the chains are unpacked only for the duration of
+        the sweep, and the returned samples are packed.
+        """
         s = {
             "key": state.rng,
-            "σ": state.σ,
+            "σ": sampler._unpack_states(state.σ),
             # Log prob is already computed in reset, so don't recompute it.
             # "log_prob": sampler.machine_pow * apply_machine(parameters, state.σ).real,
             "log_prob": state.log_prob,
             # for logging
             "accepted": state.n_accepted_proc,
         }
-        s = jax.lax.fori_loop(0, sampler.sweep_size, loop_body, s)
+        if sampler.use_fast_updates:
+            s["cache"] = state.fast_update_cache
+
+        s = _run_sweep(machine, sampler, parameters, state, s)
 
         new_state = state.replace(
             rng=s["key"],
-            σ=s["σ"],
+            σ=sampler._pack_states(s["σ"]),
             log_prob=s["log_prob"],
+            fast_update_cache=s.get("cache", None),
             n_accepted_proc=s["accepted"],
             n_steps_proc=state.n_steps_proc + sampler.sweep_size * sampler.n_batches,
         )
@@ -535,6 +657,8 @@ class MetropolisSampler(Sampler):
             + f"\n  sweep_size = {sampler.sweep_size},"
             + f"\n  reset_chains = {sampler.reset_chains},"
             + f"\n  machine_power = {sampler.machine_pow},"
+            + f"\n  use_fast_updates = {sampler.use_fast_updates},"
+            + f"\n  packed_states = {sampler.packed_states},"
             + f"\n  dtype = {sampler.dtype}"
             + ")"
         )
@@ -551,6 +675,125 @@ class MetropolisSampler(Sampler):
         )
 
 
+def _sweep(machine, sampler, parameters, state, s):
+    """
+    Performs `sampler.sweep_size` Metropolis steps on the chains in the dictionary
+    `s`, holding the random key, the configurations, their log-probabilities, the
+    number of accepted moves and optionally the fast-update cache.
+    """
+    apply_machine = apply_chunked(
+        machine.apply, in_axes=(None, 0), chunk_size=sampler.chunk_size
+    )
+    if sampler.use_fast_updates:
+        update_machine = apply_chunked(
+            partial(machine.apply, method="update_fast_update"),
+            in_axes=(None, 0, 0, 0, 0),
+            chunk_size=sampler.chunk_size,
+        )
+
+    def loop_body(i, s):
+        # 1 to propagate for next iteration, 1 for uniform rng and n_chains for transition kernel
+        s["key"], key1, key2 = jax.random.split(s["key"], 3)
+
+        σp, log_prob_correction = sampler.rule.transition(
+            sampler, machine, parameters, state, key1, s["σ"]
+        )
+        _assert_good_sample_shape(
+            σp,
+            (sampler.n_batches, sampler.hilbert.size),
+            sampler.dtype,
+            f"{sampler.rule}.transition",
+        )
+        if sampler.use_fast_updates:
+            sites = _changed_sites(s["σ"], σp, sampler.rule.max_changed_sites)
+            proposal_log_val, proposal_cache = update_machine(
+                parameters, s["cache"], s["σ"], σp, sites
+            )
+        else:
+            proposal_log_val = apply_machine(parameters, σp)
+        proposal_log_prob = sampler.machine_pow * proposal_log_val.real
+        _assert_good_log_prob_shape(proposal_log_prob, sampler.n_batches, machine)
+
+        uniform = jax.random.uniform(key2, shape=(sampler.n_batches,))
+        if log_prob_correction is not None:
+            do_accept = uniform < jnp.exp(
+                proposal_log_prob - s["log_prob"] + log_prob_correction
+            )
+        else:
+            do_accept = uniform < jnp.exp(proposal_log_prob - s["log_prob"])
+
+        # do_accept must match ndim of proposal and state (which is 2)
+        s["σ"] = jnp.where(do_accept.reshape(-1, 1), σp, s["σ"])
+        s["accepted"] += do_accept
+
+        s["log_prob"] = jax.numpy.where(
+            do_accept.reshape(-1), proposal_log_prob, s["log_prob"]
+        )
+
+        if sampler.use_fast_updates:
+            s["cache"] = jax.tree_util.tree_map(
+                lambda new, old: jnp.where(
+                    do_accept.reshape((-1,) + (1,) * (new.ndim - 1)), new, old
+                ),
+                proposal_cache,
+                s["cache"],
+            )
+
+        return s
+
+    return jax.lax.fori_loop(0, sampler.sweep_size, loop_body, s)
+
+
+def _run_sweep(machine, sampler, parameters, state, s):
+    """
+    Runs :func:`_sweep`, inside of shard_map when running with the experimental
+    sharding mode on several devices.
+    """
+    if config.netket_experimental_sharding and jax.device_count() > 1:
+        rng, key = jax.random.split(s["key"])
+        s = _sweep_shard_map(machine, sampler, parameters, state, {**s, "key": key})
+        s["key"] = rng
+        return s
+    return _sweep(machine, sampler, parameters, state, s)
+
+
+def _sweep_shard_map(machine, sampler, parameters, state, s):
+    """
+    Runs :func:`_sweep` independently on every device, each acting on its own
+    chains with a different random key. The chain-wise quantities are sharded
+    along the first axis, while the parameters, the sampler and the state of the
+    rule are replicated.
+
+    Inside of the sweep :attr:`Sampler.n_batches` is the number of chains on
+    every device, and nested calls of
+    :func:`~netket.jax.sharding.sharding_decorator` are not sharded again.
+    """
+    mesh = Mesh(jax.devices(), axis_names=("i",))
+    chain_specs = {k: P("i") for k in s}
+    chain_specs["key"] = P()
+    state_specs = jax.tree_util.tree_map(lambda _: P(), state).replace(
+        σ=P("i"), log_prob=P("i"), n_accepted_proc=P("i")
+    )
+    if state.fast_update_cache is not None:
+        state_specs = state_specs.replace(fast_update_cache=P("i"))
+
+    @partial(
+        shard_map,
+        mesh=mesh,
+        in_specs=(P(), P(), state_specs, chain_specs),
+        out_specs={k: v for k, v in chain_specs.items() if k != "key"},
+        check_rep=False,
+    )
+    def _sweep_local(sampler, parameters, state, s):
+        key = jax.random.fold_in(s["key"], jax.lax.axis_index("i"))
+        s = _sweep(machine, sampler, parameters, state, {**s, "key": key})
+        del s["key"]
+        return s
+
+    with _increase_SHARD_MAP_STACK_LEVEL():
+        return _sweep_local(sampler, parameters, state, s)
+
+
 def MetropolisLocal(hilbert, **kwargs) -> MetropolisSampler:
     r"""
     Sampler acting on one local degree of freedom.
@@ -591,6 +834,35 @@ def MetropolisLocal(hilbert, **kwargs) -> MetropolisSampler:
     return MetropolisSampler(hilbert, LocalRule(), **kwargs)
 
 
+def MetropolisHeatBath(hilbert, **kwargs) -> MetropolisSampler:
+    r"""
+    Sampler updating one local degree of freedom with the heat-bath rule.
+
+    At every step, one of the site indices :math:`i = 1\dots N` is chosen with
+    uniform probability, and the new value of :math:`s_i` is sampled from its exact
+    conditional distribution given the other sites, which is computed by
+    evaluating the model on all the values that :math:`s_i` can take in a single
+    batched call. The moves are therefore always accepted.
+
+    This is more efficient than :func:`MetropolisLocal` when the local dimension
+    is large, for example for bosons with a large maximum occupation. See
+    :class:`~netket.sampler.rules.HeatBathRule` for more details.
+
+    Args:
+        hilbert: The Hilbert space to sample.
+        n_chains: The total number of independent Markov chains across all MPI ranks. Either specify this or `n_chains_per_rank`.
+        n_chains_per_rank: Number of independent chains on every MPI rank (default = 16).
+        sweep_size: Number of sweeps for each step along the chain. Defaults to the number of sites in the Hilbert space.
+                This is equivalent to subsampling the Markov chain.
+        reset_chains: If True, resets the chain state when `reset` is called on every new sampling (default = False).
+        machine_pow: The power to which the machine should be exponentiated to generate the pdf (default = 2).
+        dtype: The dtype of the states sampled (default = np.float64).
+    """
+    from .rules import HeatBathRule
+
+    return MetropolisSampler(hilbert, HeatBathRule(), **kwargs)
+
+
 def MetropolisExchange(
     hilbert, *, clusters=None, graph=None, d_max=1, **kwargs
 ) -> MetropolisSampler:
@@ -798,6 +1070,57 @@ def MetropolisAdjustedLangevin(
     return MetropolisSampler(hilbert, rule, **kwargs)
 
 
+def MetropolisHMC(
+    hilbert,
+    step_size=0.01,
+    n_steps=10,
+    *,
+    target_acceptance=0.8,
+    chunk_size=None,
+    **kwargs,
+) -> MetropolisSampler:
+    r"""This sampler acts on all particle positions simultaneously, proposing
+    new positions with Hamiltonian Monte Carlo [1].
+
+    The positions are evolved for `n_steps` leapfrog steps of the Hamiltonian
+    dynamics :math:`H(x, p) = -\log p(x) + |p|^2/2`, starting from normally
+    distributed momenta :math:`p`. If `target_acceptance` is not None, the step
+    size is adapted at every reset of the sampler with dual averaging.
+    This sampler only works for continuous Hilbert spaces.
+
+    See :class:`~netket.sampler.rules.HMCRule` for more details.
+
+    [1]: https://en.wikipedia.org/wiki/Hamiltonian_Monte_Carlo
+
+    Args:
+        hilbert: The continuous Hilbert space to sample.
+        step_size: The (initial) step size of the leapfrog integrator.
+        n_steps: The number of leapfrog steps of every trajectory.
+        target_acceptance: The target acceptance of the step size adaptation, or
+            None to keep the step size fixed (default = 0.8).
+        chunk_size: Chunk size to compute the gradients of the log probability.
+        n_chains: The total number of independent Markov chains across all MPI ranks. Either specify this or `n_chains_per_rank`.
+        n_chains_per_rank: Number of independent chains on every MPI rank (default = 16).
+        sweep_size: Number of sweeps for each step along the chain. Defaults to the number of sites in the Hilbert space.
+                This is equivalent to subsampling the Markov chain.
+        reset_chains: If True, resets the chain state when `reset` is called on every new sampling (default = False).
+        machine_pow: The power to which the machine should be exponentiated to generate the pdf (default = 2).
+        dtype: The dtype of the states sampled (default = np.float64).
+    """
+    if not isinstance(hilbert, ContinuousHilbert):
+        raise ValueError("This sampler only works for Continuous Hilbert spaces.")
+
+    from .rules import HMCRule
+
+    rule = HMCRule(
+        step_size,
+        n_steps,
+        target_acceptance=target_acceptance,
+        chunk_size=chunk_size,
+    )
+    return MetropolisSampler(hilbert, rule, **kwargs)
+
+
 def MetropolisFermionHop(
     hilbert,
     *,
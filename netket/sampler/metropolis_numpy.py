@@ -20,12 +20,13 @@ from typing import Any
 from collections.abc import Callable
 
 import numpy as np
-from numba import jit
+from numba import jit, prange
 from jax import numpy as jnp
 import jax
 
 from netket.hilbert import AbstractHilbert
 from netket.utils.mpi import mpi_sum, n_nodes
+from netket.utils.numba_threads import use_parallel_kernels
 from netket.utils.types import PyTree
 from netket import config
 
@@ -209,6 +210,11 @@ class MetropolisSamplerNumpy(MetropolisSampler):
 
         accepted = 0
 
+        if use_parallel_kernels():
+            kernel = acceptance_kernel_parallel
+        else:
+            kernel = acceptance_kernel
+
         for sweep in range(sampler.sweep_size):
             # Propose a new state using the transition kernel
             # σp, log_prob_correction =
@@ -245,7 +251,7 @@ class MetropolisSamplerNumpy(MetropolisSampler):
             random_uniform = rgen.uniform(0, 1, size=σ.shape[0])
 
             # Acceptance Kernel
-            accepted += acceptance_kernel(
+            accepted += kernel(
                 σ,
                 σ1,
                 log_prob,
@@ -330,6 +336,27 @@ def acceptance_kernel(
     return accepted
 
 
+@jit(nopython=True, parallel=True)
+def acceptance_kernel_parallel(
+    σ, σ1, log_prob, log_prob_1, log_prob_corr, machine_pow, random_uniform
+):
+    accepted = 0
+    n_nan = 0
+
+    for i in prange(σ.shape[0]):
+        prob = np.exp(log_prob_1[i] - log_prob[i] + log_prob_corr[i])
+        if math.isnan(prob):
+            n_nan += 1
+
+        if prob > random_uniform[i]:
+            log_prob[i] = log_prob_1[i]
+            σ[i] = σ1[i]
+            accepted += 1
+
+    assert n_nan == 0
+    return accepted
+
+
 def MetropolisLocalNumpy(hilbert: AbstractHilbert, **kwargs):
     from .rules import LocalRuleNumpy
 
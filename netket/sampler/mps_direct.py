@@ -0,0 +1,188 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from functools import partial
+
+import jax
+from jax import numpy as jnp
+
+from netket.hilbert import HomogeneousHilbert
+from netket.jax.sharding import shard_along_axis
+from netket.models.tensor_networks import MPSOpen
+from netket.sampler import Sampler, SamplerState
+from netket.utils.types import PRNGKeyT, DType
+
+
+class MPSDirectSamplerState(SamplerState):
+    key: PRNGKeyT
+    """state of the random number generator."""
+
+    def __init__(self, key):
+        self.key = key
+        super().__init__()
+
+
+def _right_environments(tensors, periodic):
+    # Returns the environments of the sites i+1, ..., N-1 for every site i,
+    # normalized as only the ratios among the conditional probabilities matter.
+    #
+    # For open boundary conditions the environment R is a (D, D) matrix such that
+    # the probability of the left vector v is v R v^†. For periodic boundary
+    # conditions it is a (D, D, D, D) tensor E such that the probability of the
+    # left matrix M is Σ M[a,b] M*[c,d] E[b,d,a,c].
+    D = tensors.shape[-1]
+    eye = jnp.eye(D, dtype=tensors.dtype)
+    if periodic:
+        init = jnp.einsum("ba,dc->bdac", eye, eye)
+
+        def step(env, A):
+            env = jnp.einsum("sbe,sdf,efac->bdac", A, A.conj(), env)
+            env = env / jnp.linalg.norm(env)
+            return env, env
+
+    else:
+        init = jnp.zeros((D, D), dtype=tensors.dtype).at[0, 0].set(1)
+
+        def step(env, A):
+            env = jnp.einsum("sab,bc,sdc->ad", A, env, A.conj())
+            env = env / jnp.linalg.norm(env)
+            return env, env
+
+    _, envs = jax.lax.scan(step, init, tensors[:0:-1])
+    return jnp.concatenate([envs[::-1], init[None]])
+
+
+def _sample_local_indices(tensors, envs, key, n_samples, periodic):
+    # Samples site by site the local indices of a batch of configurations, from
+    # the conditional probabilities given by the contraction of the left part of
+    # every configuration with the right environment.
+    D = tensors.shape[-1]
+    if periodic:
+        left = jnp.broadcast_to(jnp.eye(D, dtype=tensors.dtype), (n_samples, D, D))
+    else:
+        left = jnp.zeros((n_samples, D), dtype=tensors.dtype).at[:, 0].set(1)
+    left = shard_along_axis(left, axis=0)
+
+    def step(left, xs):
+        A, env, key = xs
+        if periodic:
+            M = jnp.einsum("nab,sbc->nsac", left, A)
+            p = jnp.einsum("nsab,nscd,bdac->ns", M, M.conj(), env).real
+        else:
+            M = jnp.einsum("na,sab->nsb", left, A)
+            p = jnp.einsum("nsa,ab,nsb->ns", M, env, M.conj()).real
+        # p is positive up to rounding errors
+        s = jax.random.categorical(key, jnp.log(jnp.maximum(p, 0)), axis=-1)
+        left = jnp.take_along_axis(
+            M, s.reshape((-1,) + (1,) * (M.ndim - 1)), axis=1
+        ).squeeze(1)
+        norm = jnp.linalg.norm(left.reshape(n_samples, -1), axis=-1)
+        left = left / norm.reshape((-1,) + (1,) * (left.ndim - 1))
+        return left, s
+
+    keys = jax.random.split(key, tensors.shape[0])
+    _, indices = jax.lax.scan(step, left, (tensors, envs, keys))
+    return indices.T
+
+
+class MPSDirectSampler(Sampler):
+    r"""
+    Direct sampler for Matrix Product States.
+
+    Draws independent samples exactly distributed according to :math:`|\Psi(s)|^2`
+    for the Matrix Product States :class:`~netket.models.tensor_networks.MPSOpen`
+    and :class:`~netket.models.tensor_networks.MPSPeriodic`, or any Flax model
+    exposing a method `site_tensors` that returns the tensors :math:`A[s_i]` of
+    all the sites with shape :code:`(N, local_size, bond_dim, bond_dim)`, such that
+    :math:`\Psi(s) = \mathrm{Tr}\left[A[s_1]\dots A[s_N]\right]`.
+
+    At every sampling, the environments of the right part of the chain are
+    computed once, and the samples are then generated site by site from the
+    conditional probabilities :math:`p(s_i|s_1\dots s_{i-1})`, like for the
+    autoregressive models sampled by :class:`~netket.sampler.ARDirectSampler`.
+    Therefore, no samples need to be discarded and the samples are not correlated.
+
+    For open boundary conditions, the environments cost
+    :math:`O(N d \chi^3)` and every sample :math:`O(N d \chi^2)`, where :math:`d`
+    is the local dimension and :math:`\chi` the bond dimension. For periodic
+    boundary conditions the transfer matrices act on the doubled bond space,
+    and the costs are :math:`O(N d \chi^5)` and :math:`O(N d \chi^4)`.
+    """
+
+    def __init__(
+        self,
+        hilbert: HomogeneousHilbert,
+        machine_pow: None = None,
+        dtype: DType = None,
+    ):
+        """
+        Construct a direct sampler for Matrix Product States.
+
+        Args:
+            hilbert: The Hilbert space to sample.
+            dtype: The dtype of the states sampled (default = np.float64).
+
+        Note:
+            The samples are always distributed according to :math:`|\\Psi(s)|^2`,
+            and `machine_pow` cannot be modified.
+        """
+        if machine_pow is not None and machine_pow != 2:
+            raise ValueError(
+                "MPSDirectSampler can only sample |Ψ(s)|^2, with machine_pow=2."
+            )
+
+        if not isinstance(hilbert, HomogeneousHilbert) or hilbert.constrained:
+            raise ValueError(
+                "MPSDirectSampler can only sample unconstrained homogeneous Hilbert "
+                "spaces."
+            )
+
+        super().__init__(hilbert, machine_pow=2, dtype=dtype)
+        self.machine_pow = float(self.machine_pow)
+
+    @property
+    def is_exact(sampler):
+        """
+        Returns `True` because the sampler is exact.
+
+        The sampler is exact if all the samples are exactly distributed according to the
+        chosen power of the variational state, and there is no correlation among them.
+        """
+        return True
+
+    def _init_state(sampler, model, variables, key):
+        return MPSDirectSamplerState(key=key)
+
+    def _reset(sampler, model, variables, state):
+        return state
+
+    @partial(jax.jit, static_argnums=(1, 4))
+    def _sample_chain(sampler, model, variables, state, chain_length):
+        if not hasattr(model, "site_tensors"):
+            raise TypeError(
+                "MPSDirectSampler requires a model with a `site_tensors` method, "
+                f"such as netket.models.tensor_networks.MPSOpen, but got {model}."
+            )
+        periodic = not isinstance(model, MPSOpen)
+
+        tensors = model.apply(variables, method=model.site_tensors)
+        envs = _right_environments(tensors, periodic)
+
+        new_key, key = jax.random.split(state.key)
+        n_samples = sampler.n_batches * chain_length
+        indices = _sample_local_indices(tensors, envs, key, n_samples, periodic)
+        σ = sampler.hilbert.local_indices_to_states(indices, dtype=sampler.dtype)
+        σ = σ.reshape((sampler.n_batches, chain_length, sampler.hilbert.size))
+
+        return σ, state.replace(key=new_key)
@@ -57,6 +57,23 @@ class ParallelTemperingSamplerState(MetropolisSamplerState):
     exchange_steps: int = 0
     """Number of exchanges between the different temperatures."""
 
+    ladder: jnp.ndarray | None = None
+    """The inverse temperatures in decreasing order. Only used by samplers with
+    `adapt_betas=True`, for which they change during sampling."""
+    replica_order: jnp.ndarray | None = None
+    """For every chain, the index of the replica currently at every temperature
+    of the ladder. Only used by samplers with `adapt_betas=True`."""
+    replica_direction: jnp.ndarray | None = None
+    """For every replica, +1 if it visited :math:`\\beta=1` more recently than the
+    smallest :math:`\\beta`, -1 in the opposite case and 0 if it visited neither.
+    Only used by samplers with `adapt_betas=True`."""
+    n_visits_from_hot: jnp.ndarray | None = None
+    """Number of visits of every temperature by replicas with direction -1 since
+    the last update of the ladder. Only used by samplers with `adapt_betas=True`."""
+    n_visits: jnp.ndarray | None = None
+    """Number of visits of every temperature by replicas with a direction since
+    the last update of the ladder. Only used by samplers with `adapt_betas=True`."""
+
     def __init__(
         self,
         σ: jnp.ndarray,
@@ -64,9 +81,17 @@ class ParallelTemperingSamplerState(MetropolisSamplerState):
         rule_state: Any | None,
         beta: jnp.ndarray,
         log_prob: jnp.ndarray | None = None,
+        ladder: jnp.ndarray | None = None,
     ):
         n_chains, n_replicas = beta.shape
 
+        self.ladder = ladder
+        if ladder is not None:
+            self.replica_order = jnp.tile(jnp.arange(n_replicas), (n_chains, 1))
+            self.replica_direction = jnp.zeros((n_chains, n_replicas), dtype=jnp.int8)
+            self.n_visits_from_hot = jnp.zeros((n_chains, n_replicas), dtype=int)
+            self.n_visits = jnp.zeros((n_chains, n_replicas), dtype=int)
+
         self.beta = beta
         self.n_accepted_per_beta = jnp.zeros((n_chains, n_replicas), dtype=int)
         self.beta_0_index = jnp.zeros((n_chains,), dtype=int)
@@ -115,6 +140,48 @@ class ParallelTemperingSamplerState(MetropolisSamplerState):
         return out
 
 
+def feedback_optimized_betas(
+    betas: jax.Array, fraction_from_hot: jax.Array, rate: float = 1.0
+) -> jax.Array:
+    r"""
+    Re-spaces a ladder of inverse temperatures towards the ladder maximising the
+    flow of replicas between its two ends, following the feedback-optimized
+    scheme of `Katzgraber et al., J. Stat. Mech. P03018 (2006)
+    <https://arxiv.org/abs/cond-mat/0602085>`_.
+
+    The fraction :math:`f_t` of the replicas at temperature :math:`t` that
+    visited the smallest :math:`\beta` more recently than :math:`\beta=1` goes
+    from 0 at :math:`\beta=1` to 1 at the smallest :math:`\beta`, and the
+    optimal ladder is the one for which it decreases linearly. Every interval
+    of the ladder is assigned a number of temperatures proportional to
+    :math:`\sqrt{f_{t+1}-f_t}`, while keeping the two ends fixed.
+
+    Args:
+        betas: The current inverse temperatures, in decreasing order.
+        fraction_from_hot: The fractions :math:`f_t` measured with the current ladder.
+        rate: The update is damped as :math:`\beta \to (1-r)\beta + r\beta^\prime`.
+
+    Returns:
+        The new inverse temperatures, in decreasing order.
+    """
+    n_replicas = betas.shape[-1]
+    # a non-monotonic f only comes from noise, and must not collapse intervals
+    df = jnp.maximum(jnp.diff(fraction_from_hot), 0.1 / n_replicas)
+    weights = jnp.sqrt(df)
+    cumulative = jnp.concatenate([jnp.zeros((1,)), jnp.cumsum(weights)])
+    cumulative = cumulative / cumulative[-1]
+    target = jnp.interp(jnp.linspace(0, 1, n_replicas), cumulative, betas)
+    new_betas = (1 - rate) * betas + rate * target
+    return new_betas.at[0].set(1).at[-1].set(betas[-1])
+
+
+def _take_along_replicas(x, indices):
+    # we use shard_map to avoid the all-gather emitted by the batched jnp.take / indexing
+    return sharding_decorator(partial(jnp.take_along_axis, axis=-1), (True, True))(
+        x, indices
+    )
+
+
 class ParallelTemperingSampler(MetropolisSampler):
     """
     Metropolis-Hastings with Parallel Tempering sampler.
@@ -141,12 +208,23 @@ class ParallelTemperingSampler(MetropolisSampler):
     """
     An internal for the user-specified distribution of betas.
     """
+    adapt_betas: bool = struct.field(pytree_node=False, default=False)
+    """
+    Whether the inverse temperatures are adapted during sampling to maximise the
+    flow of replicas between β=1 and the smallest β.
+    """
+    beta_adaptation_rate: float = struct.field(pytree_node=False, default=0.5)
+    """
+    Damping of every update of the adaptive inverse temperatures.
+    """
 
     def __init__(
         self,
         *args,
         n_replicas: int | None = None,
         betas: str | jax.Array | None = "linear",
+        adapt_betas: bool = False,
+        beta_adaptation_rate: float = 0.5,
         **kwargs,
     ):
         r"""
@@ -177,6 +255,17 @@ class ParallelTemperingSampler(MetropolisSampler):
                     For the explicit list of values, the length must be even and the value β=1 must
                     obligatory be an element of betas, all other temperatures must be in (0,1].
                     (default : "lin", i.e. linear distribution between (0,1]).
+                    If `adapt_betas=True`, this is only the initial distribution.
+            adapt_betas: If True, the inverse temperatures are re-spaced during
+                    sampling towards the ladder maximising the flow of replicas
+                    between β=1 and the smallest β (feedback-optimized parallel
+                    tempering), keeping both ends fixed. The swaps are then always
+                    proposed between neighbouring temperatures of the ladder.
+                    The ladder is updated at the end of every sweep once every
+                    temperature has been visited by a replica coming from one
+                    of the ends (default: False).
+            beta_adaptation_rate: The damping, in (0, 1], of every update of the
+                    adaptive ladder (default: 0.5).
             n_chains: The number of Markov Chain to be run in parallel on a single process.
             sweep_size: The number of exchanges that compose a single sweep.
                     If None, sweep_size is equal to the number of degrees of freedom being sampled
@@ -239,9 +328,19 @@ class ParallelTemperingSampler(MetropolisSampler):
                 "n_replicas (or the length of `betas`) must be an even integer > 0."
             )
 
+        if not 0 < beta_adaptation_rate <= 1:
+            raise ValueError("beta_adaptation_rate must be in (0, 1].")
+
         self.n_replicas = n_replicas
         self._beta_sorted = betas
         self._beta_distribution = beta_distribution
+        self.adapt_betas = adapt_betas
+        self.beta_adaptation_rate = beta_adaptation_rate
+
+        if kwargs.get("use_fast_updates", False):
+            raise ValueError(
+                "ParallelTemperingSampler does not support `use_fast_updates=True`."
+            )
 
         super().__init__(*args, **kwargs)
 
@@ -276,6 +375,7 @@ class ParallelTemperingSampler(MetropolisSampler):
             + f"\n  n_chains = {sampler.n_chains},"
             + f"\n  n_replicas = {sampler.n_replicas},"
             + f"\n  beta_distribution = {sampler._beta_distribution},"
+            + f"\n  adapt_betas = {sampler.adapt_betas},"
             + f"\n  sweep_size = {sampler.sweep_size},"
             + f"\n  reset_chains = {sampler.reset_chains},"
             + f"\n  machine_power = {sampler.machine_pow},"
@@ -327,6 +427,7 @@ class ParallelTemperingSampler(MetropolisSampler):
             rng=key_state,
             rule_state=rule_state,
             beta=beta,
+            ladder=sampler.sorted_betas if sampler.adapt_betas else None,
         )
 
     @partial(jax.jit, static_argnums=1)
@@ -343,6 +444,81 @@ class ParallelTemperingSampler(MetropolisSampler):
             # beta_0_index=jnp.zeros((sampler.n_chains,), dtype=jnp.int64),
         )
 
+    def _exchange_neighbours(sampler, s, do_accept, key_order, key_swap):
+        # Swaps the replicas at neighbouring temperatures of the ladder, all the
+        # (even or odd, randomly chosen per chain) pairs at once.
+        n_rows = sampler.n_batches // sampler.n_replicas
+        ladder = s["ladder"]
+        order = s["replica_order"]
+
+        # with an adaptive ladder n_accepted_per_beta is indexed by temperature
+        s["n_accepted_per_beta"] = s["n_accepted_per_beta"] + _take_along_replicas(
+            do_accept.reshape((n_rows, sampler.n_replicas)), order
+        )
+
+        # partner in the ladder of every temperature, for the even and odd pairings.
+        t = np.arange(sampler.n_replicas)
+        partners = np.stack(
+            [t ^ 1, np.clip(t + np.where(t % 2 == 1, 1, -1), 0, sampler.n_replicas - 1)]
+        )
+        parity = jax.random.randint(key_order, (n_rows, 1), minval=0, maxval=2)
+
+        def with_partner(x):
+            # x[..., partner(t)] for the pairing of every chain
+            return jnp.where(parity == 0, x[..., partners[0]], x[..., partners[1]])
+
+        log_prob = _take_along_replicas(
+            s["log_prob"].reshape((n_rows, sampler.n_replicas)), order
+        )
+        # log of the acceptance ratio, the same for both elements of a pair
+        log_ratio = (ladder - with_partner(ladder)) * (
+            with_partner(log_prob) - log_prob
+        )
+        # both elements of a pair use the uniform number of the first one
+        uniform = jax.random.uniform(key_swap, shape=(n_rows, sampler.n_replicas))
+        uniform = jnp.where(with_partner(t) < t, with_partner(uniform), uniform)
+        do_swap = (with_partner(t) != t) & (uniform < jnp.exp(log_ratio))
+
+        order = jnp.where(do_swap, with_partner(order), order)
+        s["replica_order"] = order
+        s["beta_0_index"] = order[:, 0]
+
+        # temperature of every replica
+        temperature = jnp.argsort(order, axis=-1)
+        s["beta"] = ladder[temperature]
+
+        # statistics of the flow of replicas between the two ends of the ladder
+        direction = jnp.where(
+            temperature == 0,
+            1,
+            jnp.where(
+                temperature == sampler.n_replicas - 1, -1, s["replica_direction"]
+            ),
+        ).astype(s["replica_direction"].dtype)
+        s["replica_direction"] = direction
+        direction = _take_along_replicas(direction, order)
+        s["n_visits_from_hot"] = s["n_visits_from_hot"] + (direction == -1)
+        s["n_visits"] = s["n_visits"] + (direction != 0)
+        return s
+
+    def _adapt_ladder(sampler, s):
+        # Updates the ladder once every temperature has been visited by a replica
+        # coming from one of its ends.
+        n_visits_from_hot, _ = mpi.mpi_sum_jax(s["n_visits_from_hot"].sum(axis=0))
+        n_visits, _ = mpi.mpi_sum_jax(s["n_visits"].sum(axis=0))
+        ready = jnp.all(n_visits > 0)
+
+        new_ladder = feedback_optimized_betas(
+            s["ladder"],
+            n_visits_from_hot / jnp.maximum(n_visits, 1),
+            sampler.beta_adaptation_rate,
+        )
+        s["ladder"] = jnp.where(ready, new_ladder, s["ladder"])
+        s["n_visits_from_hot"] = jnp.where(ready, 0, s["n_visits_from_hot"])
+        s["n_visits"] = jnp.where(ready, 0, s["n_visits"])
+        s["beta"] = s["ladder"][jnp.argsort(s["replica_order"], axis=-1)]
+        return s
+
     def _sample_next(
         sampler, machine, parameters: PyTree, state: ParallelTemperingSamplerState
     ):
@@ -382,14 +558,18 @@ class ParallelTemperingSampler(MetropolisSampler):
 
             # do_accept must match ndim of proposal and state (which is 2)
             s["σ"] = jnp.where(do_accept.reshape(-1, 1), σp, s["σ"])
-            n_accepted_per_beta = s["n_accepted_per_beta"] + do_accept.reshape(
-                (sampler.n_batches // sampler.n_replicas, sampler.n_replicas)
-            )
-
             s["log_prob"] = jax.numpy.where(
                 do_accept.reshape(-1), proposal_log_prob, s["log_prob"]
             )
 
+            if sampler.adapt_betas:
+                s = sampler._exchange_neighbours(s, do_accept, key3, key4)
+                return _update_diffusion_statistics(s)
+
+            n_accepted_per_beta = s["n_accepted_per_beta"] + do_accept.reshape(
+                (sampler.n_batches // sampler.n_replicas, sampler.n_replicas)
+            )
+
             ## exchange betas
 
             # randomly decide if every set of replicas should be swapped in even or odd order
@@ -484,15 +664,7 @@ class ParallelTemperingSampler(MetropolisSampler):
                 n_accepted_per_beta,
             )
 
-            # Update statistics to compute diffusion coefficient of replicas
-            # Total exchange steps performed
-            s["exchange_steps"] += 1
-            delta = s["beta_0_index"] - s["beta_position"]
-            s["beta_position"] = s["beta_position"] + delta / s["exchange_steps"]
-            delta2 = s["beta_0_index"] - s["beta_position"]
-            s["beta_diffusion"] = s["beta_diffusion"] + delta * delta2
-
-            return s
+            return _update_diffusion_statistics(s)
 
         s = {
             "key": state.rng,
@@ -508,12 +680,24 @@ class ParallelTemperingSampler(MetropolisSampler):
             "beta_diffusion": state.beta_diffusion,
             "exchange_steps": state.exchange_steps,
         }
+        if sampler.adapt_betas:
+            s["ladder"] = state.ladder
+            s["replica_order"] = state.replica_order
+            s["replica_direction"] = state.replica_direction
+            s["n_visits_from_hot"] = state.n_visits_from_hot
+            s["n_visits"] = state.n_visits
+
         s = jax.lax.fori_loop(0, sampler.sweep_size, loop_body, s)
 
-        # we use shard_map to avoid the all-gather emitted by the batched jnp.take / indexing
-        n_accepted_proc = sharding_decorator(jax.vmap(jnp.take), (True, True))(
-            s["n_accepted_per_beta"], s["beta_0_index"]
-        )
+        if sampler.adapt_betas:
+            s = sampler._adapt_ladder(s)
+            # n_accepted_per_beta is indexed by temperature
+            n_accepted_proc = s["n_accepted_per_beta"][:, 0]
+        else:
+            # we use shard_map to avoid the all-gather emitted by the batched jnp.take / indexing
+            n_accepted_proc = sharding_decorator(jax.vmap(jnp.take), (True, True))(
+                s["n_accepted_per_beta"], s["beta_0_index"]
+            )
 
         new_state = state.replace(
             rng=s["key"],
@@ -529,6 +713,14 @@ class ParallelTemperingSampler(MetropolisSampler):
             n_accepted_per_beta=s["n_accepted_per_beta"],
             n_accepted_proc=n_accepted_proc,
         )
+        if sampler.adapt_betas:
+            new_state = new_state.replace(
+                ladder=s["ladder"],
+                replica_order=s["replica_order"],
+                replica_direction=s["replica_direction"],
+                n_visits_from_hot=s["n_visits_from_hot"],
+                n_visits=s["n_visits"],
+            )
         σ_flat = new_state.σ
         σ = σ_flat.reshape((-1, sampler.n_replicas, σ_flat.shape[-1]))
         # we use shard_map to avoid the all-gather emitted by the batched jnp.take / indexing
@@ -539,6 +731,17 @@ class ParallelTemperingSampler(MetropolisSampler):
         return new_state, σ_new
 
 
+def _update_diffusion_statistics(s):
+    # Update statistics to compute diffusion coefficient of replicas
+    # Total exchange steps performed
+    s["exchange_steps"] += 1
+    delta = s["beta_0_index"] - s["beta_position"]
+    s["beta_position"] = s["beta_position"] + delta / s["exchange_steps"]
+    delta2 = s["beta_0_index"] - s["beta_position"]
+    s["beta_diffusion"] = s["beta_diffusion"] + delta * delta2
+    return s
+
+
 def ParallelTemperingLocal(hilbert, *args, **kwargs):
     r"""
     Sampler acting on one local degree of freedom.
@@ -0,0 +1,437 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from typing import Any
+from functools import partial
+
+import numpy as np
+
+import jax
+from jax import numpy as jnp
+
+from netket.utils import struct, mpi
+from netket.utils.types import PyTree, Array
+from netket.jax.sharding import shard_along_axis
+
+from .metropolis import MetropolisSamplerState, MetropolisSampler, _run_sweep
+
+
+class PopulationAnnealingSamplerState(MetropolisSamplerState):
+    """
+    State for the Population Annealing sampler.
+
+    Contains the usual quantities, as well as the weights of the walkers and the
+    estimate of the normalization of the distribution obtained during the
+    annealing.
+    """
+
+    log_weights: jnp.ndarray = None
+    """Logarithm of the weights of the walkers (chains), normalized such that
+    their mean is 1. They are all zero if the population was resampled at the
+    end of the annealing."""
+    log_Z: jnp.ndarray = None
+    r"""Estimate of :math:`\log\left(\sum_\sigma |M(\sigma)|^p / \sum_\sigma 1\right)`,
+    the logarithm of the normalization of the distribution relative to the one of
+    the uniform distribution from which the annealing starts."""
+    n_resamplings: jnp.ndarray = None
+    """Number of resamplings of the population performed during the last reset."""
+    is_annealed: jnp.ndarray = None
+    """Whether the population has already been annealed. If the sampler does not
+    reset the chains, the following resets only reweight this population."""
+
+    def __init__(
+        self,
+        σ: jnp.ndarray,
+        rng: jnp.ndarray,
+        rule_state: Any | None,
+        log_prob: jnp.ndarray | None = None,
+        fast_update_cache: PyTree | None = None,
+    ):
+        self.log_weights = shard_along_axis(
+            jnp.zeros(σ.shape[0], dtype=float), axis=0
+        )
+        self.log_Z = jnp.zeros((), dtype=float)
+        self.n_resamplings = jnp.zeros((), dtype=int)
+        self.is_annealed = jnp.zeros((), dtype=bool)
+        super().__init__(
+            σ,
+            rng=rng,
+            rule_state=rule_state,
+            log_prob=log_prob,
+            fast_update_cache=fast_update_cache,
+        )
+
+    @property
+    def free_energy(self) -> jax.Array:
+        r"""
+        The free energy :math:`-\log Z` estimated during the annealing, relative
+        to the one of the uniform distribution.
+        """
+        return -self.log_Z
+
+    @property
+    def effective_sample_size(self) -> jax.Array:
+        """
+        The effective number of walkers given their weights, across all processes.
+        """
+        ess = jnp.exp(
+            2 * jax.nn.logsumexp(self.log_weights)
+            - jax.nn.logsumexp(2 * self.log_weights)
+        )
+        return mpi.mpi_sum_jax(ess)[0]
+
+
+def _systematic_resampling(key, log_weights):
+    # Indices of the walkers selected with probabilities proportional to their
+    # weights, with the systematic scheme, which has a lower variance than the
+    # multinomial one.
+    n = log_weights.shape[0]
+    cdf = jnp.cumsum(jax.nn.softmax(log_weights))
+    u = (jax.random.uniform(key) + jnp.arange(n)) / n
+    return jnp.minimum(jnp.searchsorted(cdf, u), n - 1)
+
+
+def _population_carry(sampler, state, key):
+    # the quantities of the walkers evolved by `_run_sweep`
+    s = {
+        "key": key,
+        "σ": sampler._unpack_states(state.σ),
+        "log_prob": state.log_prob,
+        "accepted": state.n_accepted_proc,
+    }
+    if sampler.use_fast_updates:
+        s["cache"] = state.fast_update_cache
+    return s
+
+
+def _population_step(
+    machine, sampler, parameters, state, carry, delta_log_w, beta, last
+):
+    """
+    Reweights the walkers by `exp(delta_log_w)`, resamples them if their effective
+    sample size is too small, or at the last step if `sampler.resample_final`,
+    and evolves them at inverse temperature `beta`.
+    """
+    s, log_prob, log_w, log_Z, n_resamplings = carry
+    s["key"], key_resample = jax.random.split(s["key"])
+    p = sampler.machine_pow
+
+    # reweighting
+    log_w_new = log_w + delta_log_w
+    log_Z = log_Z + jax.nn.logsumexp(log_w_new) - jax.nn.logsumexp(log_w)
+    log_w = log_w_new - jax.nn.logsumexp(log_w_new) + jnp.log(log_w.shape[0])
+
+    # resampling
+    ess = jnp.exp(2 * jax.nn.logsumexp(log_w) - jax.nn.logsumexp(2 * log_w))
+    do_resample = ess < sampler.ess_threshold * log_w.shape[0]
+    if sampler.resample_final:
+        do_resample = do_resample | last
+    indices = jnp.where(
+        do_resample,
+        _systematic_resampling(key_resample, log_w),
+        jnp.arange(log_w.shape[0]),
+    )
+    walkers = {k: v for k, v in s.items() if k != "key"}
+    walkers = jax.tree_util.tree_map(
+        partial(jnp.take, indices=indices, axis=0), walkers
+    )
+    s = {**walkers, "key": s["key"]}
+    log_prob = log_prob[indices]
+    log_w = jnp.where(do_resample, jnp.zeros_like(log_w), log_w)
+    n_resamplings = n_resamplings + do_resample
+
+    # mutation with the transition rule at inverse temperature β
+    sampler_beta = sampler.replace(machine_pow=beta * p)
+    s["log_prob"] = beta * log_prob
+    s = jax.lax.fori_loop(
+        0,
+        sampler.n_sweeps_per_temperature,
+        lambda _, s: _run_sweep(machine, sampler_beta, parameters, state, s),
+        s,
+    )
+    log_prob = s["log_prob"] / beta
+
+    return s, log_prob, log_w, log_Z, n_resamplings
+
+
+def _population_state(sampler, state, rng, carry):
+    s, log_prob, log_w, log_Z, n_resamplings = carry
+    log_Z, _ = mpi.mpi_mean_jax(log_Z)
+
+    return state.replace(
+        σ=sampler._pack_states(s["σ"]),
+        log_prob=log_prob,
+        fast_update_cache=s.get("cache", None),
+        rng=rng,
+        # the moves performed during the annealing are not counted
+        n_accepted_proc=jnp.zeros_like(state.n_accepted_proc),
+        log_weights=log_w,
+        log_Z=log_Z,
+        n_resamplings=n_resamplings,
+        is_annealed=jnp.ones((), dtype=bool),
+    )
+
+
+class PopulationAnnealingSampler(MetropolisSampler):
+    r"""
+    Population Annealing (or Sequential Monte Carlo) sampler.
+
+    At every reset (see the warning below), a population of walkers (one for
+    every chain) is drawn from the uniform distribution, and annealed through the
+    distributions :math:`P_\beta(s) \propto |M(s)|^{\beta p}` for an increasing
+    sequence of inverse temperatures :math:`0 < \beta_1 < \dots < \beta_K = 1`.
+    At every temperature
+
+    - the walkers are reweighted by :math:`|M(s)|^{(\beta_k - \beta_{k-1})p}`,
+    - if the effective sample size of the population falls below
+      `ess_threshold` times the number of walkers, they are resampled with
+      probabilities proportional to their weights,
+    - the walkers are evolved with `n_sweeps_per_temperature` sweeps of the
+      Metropolis transition rule at inverse temperature :math:`\beta_k`.
+
+    The chains then continue from the annealed population as in a
+    :class:`~netket.sampler.MetropolisSampler`, so that no samples need to be
+    discarded. This is useful for multimodal distributions, where the modes are
+    populated according to their weight already at the start of the chains.
+
+    The product of the mean weights gives an estimate of the normalization of the
+    distribution relative to the uniform one, stored in the `log_Z` field of the
+    state together with the weights of the walkers.
+
+    If `resample_final` is False, the population is not resampled at the last
+    temperature, and the samples of every chain are weighted with
+    `state.log_weights`. :class:`~netket.vqs.MCState` then computes the
+    expectation values and forces with these weights, and the error of the mean
+    with the effective sample size. The default, True, gives equally weighted
+    samples.
+
+    .. warning::
+
+        By default the whole annealing, that is `n_temperatures` times
+        `n_sweeps_per_temperature` sweeps, is performed at every reset, which
+        :class:`~netket.vqs.MCState` does at every sampling, i.e. at every step
+        of an optimization. With `reset_chains=False` the population is annealed
+        only at the first reset, and the following ones reweight the previous
+        population with the ratio of the new and old distributions, resample it
+        if needed and evolve it with `n_sweeps_per_temperature` sweeps. This
+        costs as a single temperature of the annealing and is accurate as long as
+        the distribution changes little between resets.
+
+    The initial population is generated with the `random_state` method of the
+    transition rule, which must therefore be uniform over the Hilbert space.
+    When using MPI, every rank anneals its own population and `log_Z` is the
+    average of the estimates of the ranks.
+    """
+
+    n_sweeps_per_temperature: int = struct.field(pytree_node=False, default=1)
+    """Number of sweeps of the transition rule at every temperature."""
+    ess_threshold: float = struct.field(pytree_node=False, default=0.5)
+    """Fraction of the number of walkers below which the effective sample size
+    triggers a resampling."""
+    resample_final: bool = struct.field(pytree_node=False, default=True)
+    """Whether the population is always resampled at the last temperature."""
+    _betas: jax.Array = None
+    """The increasing inverse temperatures of the annealing, ending at 1."""
+
+    def __init__(
+        self,
+        *args,
+        n_temperatures: int | None = None,
+        betas: Array | None = None,
+        n_sweeps_per_temperature: int = 1,
+        ess_threshold: float = 0.5,
+        resample_final: bool = True,
+        **kwargs,
+    ):
+        r"""
+        Constructs a Population Annealing sampler.
+
+        Args:
+            hilbert: The Hilbert space to sample.
+            rule: A `MetropolisRule` used to evolve the walkers, which also
+                generates the initial uniform population.
+            n_temperatures: The number of temperatures of the annealing, equally
+                spaced in :math:`(0, 1]` (default: 20).
+            betas: (Optional) The increasing inverse temperatures of the annealing,
+                in :math:`(0, 1]` and ending at 1. Cannot be specified together
+                with `n_temperatures`.
+            n_sweeps_per_temperature: The number of sweeps of the transition rule
+                performed at every temperature (default: 1).
+            ess_threshold: The fraction, in [0, 1], of the number of walkers below
+                which the effective sample size triggers a resampling of the
+                population (default: 0.5).
+            resample_final: Whether the population is always resampled at the last
+                temperature, such that all walkers have the same weight
+                (default: True).
+            reset_chains: If True (default), a new population is annealed at every
+                reset. Otherwise, it is annealed only at the first reset, and then
+                reweighted with the distribution at the following ones.
+            sweep_size: The number of exchanges that compose a single sweep.
+                If None, sweep_size is equal to the number of degrees of freedom
+                being sampled.
+            n_chains: The total number of walkers (independent Markov chains).
+            machine_pow: The power to which the machine should be exponentiated
+                to generate the pdf (default = 2).
+            dtype: The dtype of the states sampled (default = np.float64).
+            packed_states: If True, stores the walkers and the returned samples
+                bit-packed, as in :class:`~netket.sampler.MetropolisSampler`
+                (default = False).
+        """
+        if betas is not None:
+            if n_temperatures is not None:
+                raise ValueError("Cannot specify both betas and n_temperatures.")
+            betas = np.asarray(betas, dtype=float)
+            if betas.ndim != 1:
+                raise ValueError("betas must have exactly 1 dimension.")
+            if not (
+                np.all(np.diff(betas) > 0)
+                and betas[0] > 0
+                and np.isclose(betas[-1], 1)
+            ):
+                raise ValueError(
+                    "betas must be increasing, in (0, 1] and end with 1, "
+                    f"instead got {betas}."
+                )
+        else:
+            if n_temperatures is None:
+                n_temperatures = 20
+            if n_temperatures < 1:
+                raise ValueError("n_temperatures must be at least 1.")
+            betas = np.arange(1, n_temperatures + 1) / n_temperatures
+
+        if n_sweeps_per_temperature < 0:
+            raise ValueError("n_sweeps_per_temperature must be non-negative.")
+        if not 0 <= ess_threshold <= 1:
+            raise ValueError("ess_threshold must be in [0, 1].")
+        kwargs.setdefault("reset_chains", True)
+
+        self._betas = jnp.asarray(betas)
+        self.n_sweeps_per_temperature = n_sweeps_per_temperature
+        self.ess_threshold = ess_threshold
+        self.resample_final = resample_final
+
+        super().__init__(*args, **kwargs)
+
+    @property
+    def betas(self) -> jax.Array:
+        """The increasing inverse temperatures of the annealing, ending at 1."""
+        return self._betas
+
+    @property
+    def n_temperatures(self) -> int:
+        """The number of temperatures of the annealing."""
+        return self._betas.shape[0]
+
+    @partial(jax.jit, static_argnums=1)
+    def _init_state(sampler, machine, parameters, key):
+        state = super()._init_state(machine, parameters, key)
+        return PopulationAnnealingSamplerState(
+            σ=state.σ,
+            rng=state.rng,
+            rule_state=state.rule_state,
+            log_prob=state.log_prob,
+            fast_update_cache=state.fast_update_cache,
+        )
+
+    @partial(jax.jit, static_argnums=1)
+    def _reset(sampler, machine, parameters, state):
+        if sampler.reset_chains:
+            return sampler._anneal(machine, parameters, state)
+        return jax.lax.cond(
+            state.is_annealed,
+            partial(sampler._reweight, machine, parameters),
+            partial(sampler._anneal, machine, parameters),
+            state,
+        )
+
+    def _anneal(sampler, machine, parameters, state):
+        # draws the uniform population and computes its log-probability at β=1
+        state = MetropolisSampler._reset(
+            sampler.replace(reset_chains=True), machine, parameters, state
+        )
+        rng, key = jax.random.split(state.rng)
+
+        betas = sampler.betas
+        beta_steps = jnp.stack([jnp.concatenate([jnp.zeros(1), betas[:-1]]), betas])
+        is_last = jnp.arange(sampler.n_temperatures) == sampler.n_temperatures - 1
+
+        def anneal(carry, xs):
+            (beta_old, beta), last = xs
+            log_prob = carry[1]
+            carry = _population_step(
+                machine,
+                sampler,
+                parameters,
+                state,
+                carry,
+                (beta - beta_old) * log_prob,
+                beta,
+                last,
+            )
+            return carry, None
+
+        carry = (
+            _population_carry(sampler, state, key),
+            state.log_prob,
+            jnp.zeros_like(state.log_weights),
+            jnp.zeros_like(state.log_Z),
+            jnp.zeros_like(state.n_resamplings),
+        )
+        carry, _ = jax.lax.scan(anneal, carry, (beta_steps.T, is_last))
+        return _population_state(sampler, state, rng, carry)
+
+    def _reweight(sampler, machine, parameters, state):
+        # keeps the population and computes its log-probability with the new
+        # parameters, with which the walkers are reweighted
+        log_prob_old = state.log_prob
+        state = MetropolisSampler._reset(
+            sampler.replace(reset_chains=False), machine, parameters, state
+        )
+        rng, key = jax.random.split(state.rng)
+
+        carry = (
+            _population_carry(sampler, state, key),
+            state.log_prob,
+            state.log_weights,
+            state.log_Z,
+            jnp.zeros_like(state.n_resamplings),
+        )
+        carry = _population_step(
+            machine,
+            sampler,
+            parameters,
+            state,
+            carry,
+            state.log_prob - log_prob_old,
+            jnp.ones((), dtype=float),
+            jnp.ones((), dtype=bool),
+        )
+        return _population_state(sampler, state, rng, carry)
+
+    def __repr__(sampler):
+        return (
+            f"{type(sampler).__name__}("
+            + f"\n  hilbert = {sampler.hilbert},"
+            + f"\n  rule = {sampler.rule},"
+            + f"\n  n_chains = {sampler.n_chains},"
+            + f"\n  n_temperatures = {sampler.n_temperatures},"
+            + f"\n  n_sweeps_per_temperature = {sampler.n_sweeps_per_temperature},"
+            + f"\n  ess_threshold = {sampler.ess_threshold},"
+            + f"\n  resample_final = {sampler.resample_final},"
+            + f"\n  reset_chains = {sampler.reset_chains},"
+            + f"\n  sweep_size = {sampler.sweep_size},"
+            + f"\n  machine_power = {sampler.machine_pow},"
+            + f"\n  dtype = {sampler.dtype}"
+            + ")"
+        )
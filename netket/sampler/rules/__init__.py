@@ -16,12 +16,15 @@ from .base import MetropolisRule
 
 from .fixed import FixedRule
 from .local import LocalRule
+from .heat_bath import HeatBathRule
 from .exchange import ExchangeRule
-from .hamiltonian import HamiltonianRule
+from .hamiltonian import HamiltonianRule, HamiltonianRuleJax, HamiltonianRuleNumba
 from .continuous_gaussian import GaussianRule
 from .langevin import LangevinRule
+from .hmc import HMCRule, HMCRuleState
 from .tensor import TensorRule
 from .multiple import MultipleRules
+from .multiple_try import MultipleTryRule
 from .fermion_2nd import FermionHopRule
 
 # numpy backend
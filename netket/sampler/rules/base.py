@@ -34,6 +34,18 @@ class MetropolisRule(struct.Pytree):
     and several others.
     """
 
+    @property
+    def max_changed_sites(self) -> int | None:
+        """
+        The maximum number of sites that can be modified by a single call to
+        :meth:`~netket.sampler.rules.MetropolisRule.transition`, or `None` if
+        this is not known.
+
+        Rules with a finite value can be used together with the fast-update
+        protocol of :class:`~netket.sampler.MetropolisSampler`.
+        """
+        return None
+
     def init_state(
         self,
         sampler: "sampler.MetropolisSampler",  # noqa: F821
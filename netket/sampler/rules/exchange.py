@@ -118,6 +118,10 @@ class ExchangeRule(MetropolisRule):
 
         self.clusters = jnp.array(clusters)
 
+    @property
+    def max_changed_sites(self) -> int:
+        return 2
+
     def transition(rule, sampler, machine, parameters, state, key, σ):
         n_chains = σ.shape[0]
 
@@ -15,15 +15,15 @@
 import math
 
 import jax
-import jax.numpy as jnp
 
 import numpy as np
 
-from numba import jit
+from numba import jit, prange
 
 from netket import config
 from netket.operator import DiscreteOperator, DiscreteJaxOperator
 from netket.utils import struct
+from netket.utils.numba_threads import use_parallel_kernels
 
 from .base import MetropolisRule
 
@@ -101,7 +101,10 @@ class HamiltonianRuleNumba(HamiltonianRuleBase):
             sections = np.empty(v.shape[0], dtype=np.int32)
             vp, _ = rule.operator.get_conn_flattened(v, sections)
 
-            _choose(vp, sections, rand_vec, v_proposed, log_prob_corr)
+            if use_parallel_kernels():
+                _choose_parallel(vp, sections, rand_vec, v_proposed, log_prob_corr)
+            else:
+                _choose(vp, sections, rand_vec, v_proposed, log_prob_corr)
 
             rule.operator.n_conn(v_proposed, sections)
 
@@ -139,6 +142,16 @@ def _choose(vp, sections, rand_vec, out, w):
         low_range = s
 
 
+@jit(nopython=True, parallel=True)
+def _choose_parallel(vp, sections, rand_vec, out, w):
+    for i in prange(sections.shape[0]):
+        low_range = sections[i - 1] if i > 0 else 0
+        s = sections[i]
+        n_rand = low_range + int(np.floor(rand_vec[i] * (s - low_range)))
+        out[i] = vp[n_rand]
+        w[i] = math.log(s - low_range)
+
+
 @struct.dataclass
 class HamiltonianRuleJax(HamiltonianRuleBase):
     r"""
@@ -150,66 +163,48 @@ class HamiltonianRuleJax(HamiltonianRuleBase):
 
        T( \mathbf{s} \rightarrow \mathbf{s}^\prime) = \frac{1}{\mathcal{N}(\mathbf{s})}\theta(|H_{\mathbf{s},\mathbf{s}^\prime}|),
 
+    where :math:`\mathcal{N}(\mathbf{s})` is the number of states
+    :math:`\mathbf{s}^\prime \neq \mathbf{s}` with a non-zero matrix element, so
+    that moves whose matrix elements cancel, such as those of
+    :math:`XX + YY` on parallel spins, are never proposed.
+
+    Or, if `weighted=True`,
+
+    .. math::
+
+       T( \mathbf{s} \rightarrow \mathbf{s}^\prime) = \frac{|H_{\mathbf{s},\mathbf{s}^\prime}|}{\sum_{\mathbf{s}^{\prime\prime}}|H_{\mathbf{s},\mathbf{s}^{\prime\prime}}|}.
+
+    The moves are proposed by :meth:`~netket.operator.DiscreteJaxOperator.sample_conn`.
+    With `weighted=False`, :class:`~netket.operator.PauliStringsJax` and
+    :class:`~netket.operator.FermionOperator2ndJax` implement it by choosing
+    a single off-diagonal term (for Pauli strings, a group of strings flipping
+    the same sites) uniformly among all of them, and propose to stay in
+    :math:`\mathbf{s}` if the chosen term vanishes on it. This is a different
+    symmetric proposal than the one above, whose cost does not depend on the
+    number of terms. With `weighted=True`, the matrix elements of all the terms
+    are computed.
+
     This rule only works with operators which are written in jax.
     """
 
     operator: DiscreteJaxOperator = struct.field(pytree_node=True)
     """The (hermitian) operator giving the transition amplitudes."""
+    weighted: bool = struct.field(pytree_node=False, default=False)
+    """Whether the moves are weighted by the absolute value of the matrix elements."""
 
-    def __init__(self, operator: DiscreteJaxOperator):
+    def __init__(self, operator: DiscreteJaxOperator, *, weighted: bool = False):
         if not isinstance(operator, DiscreteJaxOperator):
             raise TypeError(
                 "Argument to HamiltonianRule must be a valid operator, "
                 f"but operator is a {type(operator)}."
             )
         self.operator = operator
+        self.weighted = weighted
 
     def transition(self, _0, _1, _2, _3, key, x):
-        xp, mels = self.operator.get_conn_padded(x)
-
-        n_conn = self.operator.n_conn(x)
-
-        # def _n_conn(mels):
-        #     nonzeros = jnp.abs(mels) > 0
-        #     return nonzeros.sum(axis=-1)
-        # n_conn = _n_conn(mels)
-
-        rand_i = jax.random.randint(key, shape=(x.shape[0],), minval=0, maxval=n_conn)
-
-        # we need to shift rand_i so that we only select the nonzeros
-        #
-        # if we were to assume that the nonzero mels are gathered at the beginning of each
-        # row we could avoid this, i.e. just do
-        # x_proposed = xp[jnp.arange(xp.shape[0]), rand_i]
-        #
-        # instead of actually shifting we build a mask for the selected element in each row
-        # and sum over the zeros at the end
-
-        # TODO let the operator supply the nonzeros or nonzero_i_plus1 directly
-        nonzeros = jnp.abs(mels) > 0
-        nonzero_i_plus1 = (jnp.cumsum(nonzeros, axis=-1)) * nonzeros
-        rand_i_mask = nonzero_i_plus1 == jnp.expand_dims(rand_i + 1, -1)
-        # .sum promotes the dtype, so we must convert it to xp dtype
-        x_proposed = (xp * jnp.expand_dims(rand_i_mask, -1)).sum(axis=1, dtype=xp.dtype)
-        n_conn_proposed = self.operator.n_conn(x_proposed)
-
-        # _, mels_proposed = self.operator.get_conn_padded(x_proposed)
-        # n_conn_proposed = _n_conn(mels_proposed)
-
-        # if there are no connected elements x_proposed might
-        # contain illegal states (i.e. zeros)
-        # and log_prob_corr will be nan
-        # TODO is it safe to assume that n_conn >=1 ?
-        #
-        # no_nonzeros = nonzeros.sum(axis=-1) == 0
-        # x_proposed = jax.lax.select(
-        #     jax.lax.broadcast_in_dim(no_nonzeros, x.shape, (0,)), x, x_proposed
-        # )
-        # n_conn = jnp.maximum(n_conn, 1)
-        # n_conn_proposed = jnp.maximum(n_conn_proposed, 1)
-
-        log_prob_corr = jnp.log(n_conn) - jnp.log(n_conn_proposed)
-
+        x_proposed, log_prob_corr = self.operator.sample_conn(
+            key, x, weighted=self.weighted
+        )
         return x_proposed.astype(x.dtype), log_prob_corr
 
 
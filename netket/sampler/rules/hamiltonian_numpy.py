@@ -14,12 +14,13 @@
 
 import math
 
-from numba import jit
+from numba import jit, prange
 
 import numpy as np
 
 from netket.operator import DiscreteOperator
 from netket.utils import struct
+from netket.utils.numba_threads import use_parallel_kernels
 
 from .base import MetropolisRule
 
@@ -88,7 +89,10 @@ class HamiltonianRuleNumpy(MetropolisRule):
 
         rand_vec = rng.uniform(0, 1, size=σ.shape[0])
 
-        _choose(σp, sections, σ1, log_prob_corr, rand_vec)
+        if use_parallel_kernels():
+            _choose_parallel(σp, sections, σ1, log_prob_corr, rand_vec)
+        else:
+            _choose(σp, sections, σ1, log_prob_corr, rand_vec)
         rule.operator.n_conn(σ1, sections)
         log_prob_corr -= np.log(sections)
 
@@ -104,3 +108,13 @@ def _choose(states, sections, out, w, rand_vec):
         out[i] = states[n_rand]
         w[i] = math.log(s - low_range)
         low_range = s
+
+
+@jit(nopython=True, parallel=True)
+def _choose_parallel(states, sections, out, w, rand_vec):
+    for i in prange(sections.shape[0]):
+        low_range = sections[i - 1] if i > 0 else 0
+        s = sections[i]
+        n_rand = low_range + int(np.floor(rand_vec[i] * (s - low_range)))
+        out[i] = states[n_rand]
+        w[i] = math.log(s - low_range)
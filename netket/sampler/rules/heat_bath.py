@@ -0,0 +1,127 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import jax
+from jax import numpy as jnp
+
+from netket.hilbert import DiscreteHilbert
+from netket.jax import apply_chunked
+
+from .base import MetropolisRule
+
+
+def _local_states_table(hilbert: DiscreteHilbert) -> tuple[np.ndarray, np.ndarray]:
+    # Returns an array of shape (N, max_local_size) with the local states of every
+    # site, padded with the first local state, and the mask of the valid entries.
+    local_states = []
+    for i in range(hilbert.size):
+        states = hilbert.states_at_index(i)
+        if states is None:
+            raise ValueError(
+                "The heat-bath rule requires a finite number of local states, but "
+                f"site {i} of {hilbert} has infinitely many."
+            )
+        local_states.append(np.asarray(states))
+
+    max_local_size = max(len(s) for s in local_states)
+    table = np.empty((hilbert.size, max_local_size))
+    mask = np.zeros((hilbert.size, max_local_size), dtype=bool)
+    for i, states in enumerate(local_states):
+        table[i] = states[0]
+        table[i, : len(states)] = states
+        mask[i, : len(states)] = True
+    return table, mask
+
+
+class HeatBathRule(MetropolisRule):
+    r"""
+    A heat-bath (Gibbs) transition rule acting on one local degree of freedom.
+
+    This transition acts on one local degree of freedom :math:`s_i`, chosen with
+    uniform probability, and samples its new value from the exact conditional
+    distribution
+
+    .. math::
+
+       T(\mathbf{s} \rightarrow \mathbf{s}^\prime) =
+       \frac{|\psi(s_1 \dots s^\prime_i \dots s_N)|^2}
+       {\sum_{s^{\prime\prime}_i} |\psi(s_1 \dots s^{\prime\prime}_i \dots s_N)|^2},
+
+    where the sum runs over all the values that :math:`s_i` can take. The
+    model is evaluated on all of those in a single batched call, so that the
+    proposed moves are always accepted. This is advantageous compared to
+    :class:`~netket.sampler.rules.LocalRule` when the local dimension is large,
+    as for bosons with a large maximum occupation, where most of the uniformly
+    proposed local moves would be rejected.
+
+    The cost of a step is one evaluation of the model on
+    :math:`n_\text{chains}\times m` states, where :math:`m` is the local
+    dimension, plus the evaluation of the proposed states done by the
+    Metropolis sampler.
+
+    This rule cannot be used with constrained Hilbert spaces.
+    """
+
+    @property
+    def max_changed_sites(self) -> int:
+        return 1
+
+    def transition(rule, sampler, machine, parameters, state, key, σ):
+        hilb = sampler.hilbert
+        if hilb.constrained:
+            raise TypeError(
+                "The heat-bath rule cannot be used with constrained Hilbert spaces."
+            )
+        table, mask = _local_states_table(hilb)
+        n_chains = σ.shape[0]
+        max_local_size = table.shape[1]
+
+        key1, key2 = jax.random.split(key, 2)
+        indxs = jax.random.randint(key1, shape=(n_chains,), minval=0, maxval=hilb.size)
+
+        # all the states obtained by changing the local state at the chosen sites,
+        # of shape (n_chains, max_local_size, N)
+        is_site = jnp.arange(hilb.size) == indxs[:, None, None]
+        values = jnp.asarray(table, dtype=σ.dtype)[indxs][:, :, None]
+        candidates = jnp.where(is_site, values, σ[:, None, :])
+
+        apply_machine = apply_chunked(
+            machine.apply, in_axes=(None, 0), chunk_size=sampler.chunk_size
+        )
+        log_prob = sampler.machine_pow * (
+            apply_machine(parameters, candidates.reshape(-1, hilb.size))
+            .reshape(n_chains, max_local_size)
+            .real
+        )
+        log_prob = jnp.where(jnp.asarray(mask)[indxs], log_prob, -jnp.inf)
+
+        k = jax.random.categorical(key2, log_prob)
+        σp = jnp.take_along_axis(candidates, k[:, None, None], axis=1)[:, 0]
+
+        # The forward and reverse moves are proposed with probabilities
+        # proportional to p(σp) and p(σ), so that the correction makes the
+        # acceptance probability equal to one.
+        k_current = jnp.take_along_axis(
+            hilb.states_to_local_indices(σ), indxs[:, None], axis=1
+        )[:, 0]
+        log_prob_corr = (
+            jnp.take_along_axis(log_prob, k_current[:, None], axis=1)[:, 0]
+            - jnp.take_along_axis(log_prob, k[:, None], axis=1)[:, 0]
+        )
+        return σp, log_prob_corr
+
+    def __repr__(self):
+        return "HeatBathRule()"
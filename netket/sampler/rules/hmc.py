@@ -0,0 +1,236 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from functools import partial
+
+import jax
+import jax.numpy as jnp
+import numpy as np
+
+from flax import struct as flax_struct
+
+from netket.utils import mpi, struct
+
+from .base import MetropolisRule
+from .langevin import _grad_log_prob
+
+
+@struct.dataclass
+class HMCRuleState:
+    """State of the :class:`~netket.sampler.rules.HMCRule`, holding the variables
+    of the dual-averaging adaptation of the step size."""
+
+    step_size: jax.Array
+    """The step size of the leapfrog integrator used for the next sampling."""
+    log_step_size_bar: jax.Array
+    """Running average of the logarithm of the step size."""
+    h_bar: jax.Array
+    """Running average of the difference between the target and the measured
+    acceptance."""
+    n_adapt: jax.Array
+    """Number of adaptation steps performed."""
+
+
+class HMCRule(MetropolisRule):
+    r"""
+    A transition rule that uses Hamiltonian Monte Carlo [1] to update samples.
+
+    The positions :math:`x` are evolved together with auxiliary momenta
+    :math:`p`, drawn from a normal distribution at every transition, according
+    to the Hamiltonian dynamics of :math:`H(x, p) = -\log p(x) + |p|^2/2`. The
+    dynamics is integrated with `n_steps` steps of the leapfrog integrator, which
+    is reversible and preserves the volume of phase space, so that the move is
+    accepted with probability :math:`\min(1, e^{-\Delta H})`.
+
+    Compared to :class:`~netket.sampler.rules.LangevinRule`, which corresponds to
+    a single leapfrog step, the long trajectories decorrelate the samples with
+    far fewer gradient evaluations. Every transition costs `n_steps + 1`
+    evaluations of the gradient of the log probability.
+
+    If `target_acceptance` is not None, the step size is adapted with the
+    dual-averaging algorithm of [2] to obtain the target acceptance. The
+    adaptation uses the acceptance measured since the previous reset of the
+    sampler, and is therefore performed every time that the sampler is reset,
+    for example at every sampling of a :class:`~netket.vqs.MCState`.
+
+    Periodic boundary conditions of the Hilbert space are respected by folding
+    the positions back in the simulation box after every step.
+
+    This rule only works for continuous Hilbert spaces.
+
+    [1]: https://en.wikipedia.org/wiki/Hamiltonian_Monte_Carlo
+
+    [2]: M. D. Hoffman and A. Gelman, The No-U-Turn Sampler, JMLR 15, 1593 (2014).
+    """
+
+    step_size: float
+    """Initial step size of the leapfrog integrator."""
+    n_steps: int = flax_struct.field(pytree_node=False)
+    """Number of leapfrog steps of a trajectory."""
+    target_acceptance: float | None = flax_struct.field(pytree_node=False)
+    """Target acceptance of the step size adaptation, or None to disable it."""
+    chunk_size: int | None = flax_struct.field(pytree_node=False)
+    """Chunk size for computing gradients of the ansatz."""
+
+    def __init__(
+        self,
+        step_size: float = 0.01,
+        n_steps: int = 10,
+        *,
+        target_acceptance: float | None = 0.8,
+        chunk_size: int | None = None,
+    ):
+        """
+        Constructs the Hamiltonian Monte Carlo proposal rule.
+
+        Args:
+            step_size: the (initial) step size of the leapfrog integrator
+                (default=0.01).
+            n_steps: the number of leapfrog steps of every trajectory (default=10).
+            target_acceptance: the target acceptance of the step size adaptation,
+                or None to keep the step size fixed (default=0.8).
+            chunk_size: optional chunk size to reduce memory usage
+        """
+        if n_steps < 1:
+            raise ValueError("n_steps must be at least 1.")
+        if target_acceptance is not None and not 0 < target_acceptance < 1:
+            raise ValueError("target_acceptance must be in (0, 1).")
+        self.step_size = step_size
+        self.n_steps = n_steps
+        self.target_acceptance = target_acceptance
+        self.chunk_size = chunk_size
+
+    def init_state(self, sampler, machine, params, key):
+        log_step_size = jnp.log(jnp.asarray(self.step_size, dtype=float))
+        return HMCRuleState(
+            step_size=jnp.exp(log_step_size),
+            log_step_size_bar=log_step_size,
+            h_bar=jnp.zeros((), dtype=float),
+            n_adapt=jnp.zeros((), dtype=int),
+        )
+
+    def reset(self, sampler, machine, params, sampler_state):
+        rule_state = sampler_state.rule_state
+        if self.target_acceptance is None:
+            return rule_state
+
+        n_steps = sampler_state.n_steps_proc * mpi.n_nodes
+        n_accepted = mpi.mpi_sum_jax(jnp.sum(sampler_state.n_accepted_proc))[0]
+        acceptance = n_accepted / jnp.maximum(n_steps, 1)
+        new_rule_state = _dual_averaging_update(
+            rule_state, acceptance, self.target_acceptance, self.step_size
+        )
+        # nothing to adapt if no sampling was performed since the last reset
+        return jax.tree_util.tree_map(
+            partial(jnp.where, n_steps > 0), new_rule_state, rule_state
+        )
+
+    def transition(rule, sampler, machine, parameters, state, key, r):
+        if jnp.issubdtype(r.dtype, jnp.complexfloating):
+            raise TypeError("HMCRule does not work with complex basis elements.")
+
+        hilb = sampler.hilbert
+
+        pbc = np.array(hilb.n_particles * hilb.pbc, dtype=bool)
+        Ls = np.array(hilb.n_particles * hilb.extent, dtype=r.dtype)
+        modulus = np.where(pbc, Ls, jnp.inf)
+
+        rp, log_corr = _leapfrog_trajectory(
+            key,
+            r,
+            machine.apply,
+            parameters,
+            sampler.machine_pow,
+            state.rule_state.step_size.astype(r.dtype),
+            pbc,
+            modulus,
+            n_steps=rule.n_steps,
+            chunk_size=rule.chunk_size,
+        )
+        return rp, log_corr
+
+    def __repr__(self):
+        return (
+            f"HMCRule(step_size={self.step_size}, n_steps={self.n_steps}, "
+            f"target_acceptance={self.target_acceptance})"
+        )
+
+
+def _dual_averaging_update(
+    rule_state,
+    acceptance,
+    target_acceptance,
+    step_size_0,
+    gamma=0.05,
+    t0=10,
+    kappa=0.75,
+):
+    # Algorithm 5 of Hoffman and Gelman
+    mu = jnp.log(10 * step_size_0)
+    m = rule_state.n_adapt + 1
+    h_bar = (1 - 1 / (m + t0)) * rule_state.h_bar + (
+        target_acceptance - acceptance
+    ) / (m + t0)
+    log_step_size = mu - jnp.sqrt(m) / gamma * h_bar
+    eta = m ** (-kappa)
+    log_step_size_bar = eta * log_step_size + (1 - eta) * rule_state.log_step_size_bar
+    return HMCRuleState(
+        step_size=jnp.exp(log_step_size),
+        log_step_size_bar=log_step_size_bar,
+        h_bar=h_bar,
+        n_adapt=m,
+    )
+
+
+@partial(jax.jit, static_argnames=("apply_fun", "n_steps", "chunk_size"))
+def _leapfrog_trajectory(
+    key,
+    r,
+    apply_fun,
+    parameters,
+    machine_pow,
+    step_size,
+    pbc,
+    modulus,
+    *,
+    n_steps,
+    chunk_size=None,
+):
+    """Leapfrog integration of a trajectory starting from r with random momenta"""
+
+    def _grad(x):
+        return _grad_log_prob(apply_fun, parameters, machine_pow, x, chunk_size)
+
+    def _fold(x):
+        return jnp.where(pbc, x % modulus, x)
+
+    p0 = jax.random.normal(key, shape=r.shape, dtype=r.dtype)
+
+    # half step of the momenta, then alternating full steps
+    p = p0 + 0.5 * step_size * _grad(r)
+
+    def body(i, carry):
+        x, p = carry
+        x = _fold(x + step_size * p)
+        p = p + step_size * _grad(x)
+        return x, p
+
+    x, p = jax.lax.fori_loop(0, n_steps - 1, body, (r, p))
+    x = _fold(x + step_size * p)
+    p = p + 0.5 * step_size * _grad(x)
+
+    # the kinetic part of the change in energy, the potential part being
+    # accounted for by the Metropolis sampler
+    log_corr = 0.5 * (jnp.sum(p0**2, axis=-1) - jnp.sum(p**2, axis=-1))
+    return x, log_corr
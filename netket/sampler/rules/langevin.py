@@ -86,6 +86,22 @@ class LangevinRule(MetropolisRule):
         return f"LangevinRule(dt={self.dt})"
 
 
+def _grad_log_prob(apply_fun, parameters, machine_pow, r, chunk_size=None):
+    """Gradient of the log probability with respect to every sample in r"""
+
+    def _log_prob(x):
+        """Conversion to a log probability"""
+        return machine_pow * apply_fun(parameters, x).real
+
+    def _single_grad(x):
+        """Derivative of log_prob with respect to a single sample x"""
+        x = x.reshape(x.shape[-1])
+        g = nkjax.grad(lambda xi: _log_prob(xi).ravel()[0])(x)
+        return g if jnp.iscomplexobj(r) else g.real
+
+    return nkjax.vmap_chunked(_single_grad, chunk_size=chunk_size)(r)
+
+
 @partial(jax.jit, static_argnames=("apply_fun", "chunk_size", "return_log_corr"))
 def _langevin_step(
     key,
@@ -104,17 +120,7 @@ def _langevin_step(
     # steps with Langevin dynamics
     noise_vec = jax.random.normal(key, shape=(n_chains, hilb_size), dtype=r.dtype)
 
-    def _log_prob(x):
-        """Conversion to a log probability"""
-        return machine_pow * apply_fun(parameters, x).real
-
-    def _single_grad(x):
-        """Derivative of log_prob with respect to a single sample x"""
-        x = x.reshape(x.shape[-1])
-        g = nkjax.grad(lambda xi: _log_prob(xi).ravel()[0])(x)
-        return g if jnp.iscomplexobj(r) else g.real
-
-    grad_logp_r = nkjax.vmap_chunked(_single_grad, chunk_size=chunk_size)(r)
+    grad_logp_r = _grad_log_prob(apply_fun, parameters, machine_pow, r, chunk_size)
 
     rp = r + dt * grad_logp_r + jnp.sqrt(2 * dt) * noise_vec
 
@@ -122,7 +128,9 @@ def _langevin_step(
         return rp
     else:
         log_q_xp = -0.5 * jnp.sum(noise_vec**2, axis=-1)
-        grad_logp_rp = nkjax.vmap_chunked(_single_grad, chunk_size=chunk_size)(rp)
+        grad_logp_rp = _grad_log_prob(
+            apply_fun, parameters, machine_pow, rp, chunk_size
+        )
         log_q_x = -jnp.sum((r - rp - dt * grad_logp_rp) ** 2, axis=-1) / (4 * dt)
 
         return rp, log_q_x - log_q_xp
@@ -37,6 +37,10 @@ class LocalRule(MetropolisRule):
     one of them is chosen with uniform probability.
     """
 
+    @property
+    def max_changed_sites(self) -> int:
+        return 1
+
     def transition(rule, sampler, machine, parameters, state, key, σ):
         key1, key2 = jax.random.split(key, 2)
 
@@ -81,6 +81,13 @@ class MultipleRules(MetropolisRule):
         self.rules = rules
         self.probabilities = probabilities
 
+    @property
+    def max_changed_sites(self) -> int | None:
+        n_sites = [rule.max_changed_sites for rule in self.rules]
+        if any(n is None for n in n_sites):
+            return None
+        return max(n_sites)
+
     def init_state(
         self,
         sampler: "sampler.MetropolisSampler",  # noqa: F821
@@ -267,3 +267,19 @@ def _statistics(data):
     res = Stats(mean, error_of_mean, variance, tau_avg, R_hat, tau_max)
 
     return res
+
+
+def _weighted_statistics(data, weights, n_samples):
+    """
+    Statistics of independent samples `data`, given with their weights `weights`
+    (summing to 1 across all processes), such as distinct samples weighted by
+    their number of occurrences among `n_samples` samples. For other weights,
+    `n_samples` is the effective sample size determining the error of the mean.
+
+    The entries with zero weight are ignored, even if they are not finite.
+    """
+    data = jnp.where(weights > 0, data, 0)
+    mean, _ = mpi.mpi_sum_jax(jnp.sum(weights * data))
+    variance, _ = mpi.mpi_sum_jax(jnp.sum(weights * jnp.abs(data - mean) ** 2))
+    error_of_mean = jnp.sqrt(variance / n_samples)
+    return Stats(mean, error_of_mean, variance)
@@ -42,11 +42,13 @@ def int_env(varname: str, default: int) -> int:
     return int(os.getenv(varname, default))
 
 
-def get_env(varname: str, type, default: int | bool) -> int | bool:
+def get_env(varname: str, type, default: int | bool | str) -> int | bool | str:
     if type is int:
         return int_env(varname, default)
     elif type is bool:
         return bool_env(varname, default)  # type: ignore
+    elif type is str:
+        return os.getenv(varname, default)
     else:
         raise TypeError(f"Unknown type {type}")
 
@@ -86,7 +88,7 @@ class Config:
 
         Args:
             name: the flag name, should be an uppercase string like "NETKET_XXX"
-            type: should be the type (bool, int) of the flag
+            type: should be the type (bool, int, str) of the flag
             default: default value
             help: a string to use as description of this flag
             runtime: whether the flag can be modified at runtime
@@ -426,3 +428,38 @@ config.define(
         """
     ),
 )
+
+
+config.define(
+    "NETKET_LOCAL_OPERATOR_CACHE_DIR",
+    str,
+    default="",
+    runtime=True,
+    help=dedent(
+        """
+        If set to a directory, the packed internal arrays of
+        :class:`netket.operator.LocalOperator` are cached on disk in this directory,
+        keyed by a hash of the content of the operator, and reused by all processes
+        constructing the same operator. This reduces the startup time of many
+        short runs. Disabled by default (empty string).
+        """
+    ),
+)
+
+
+config.define(
+    "NETKET_NUMBA_NUM_THREADS",
+    int,
+    default=1,
+    runtime=True,
+    help=dedent(
+        """
+        Number of threads used by the multithreaded numba kernels of
+        :class:`netket.operator.LocalOperator` and of the numpy Metropolis samplers.
+        Defaults to 1, which uses the single-threaded kernels. Set to 0 to use all
+        the threads available to numba (``NUMBA_NUM_THREADS``). When running with
+        MPI, the product of this number and of the ranks per node should not
+        exceed the number of cores.
+        """
+    ),
+)
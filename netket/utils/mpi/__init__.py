@@ -42,6 +42,7 @@ from .primitives import (
     mpi_gather,
     mpi_gather_jax,
     mpi_alltoall_jax,
+    mpi_sendrecv_jax,
     mpi_reduce_sum_jax,
     mpi_allreduce_sum_jax,
     mpi_scatter_jax,
@@ -421,6 +421,31 @@ def mpi_alltoall_jax(x, *, token=None, comm=MPI_jax_comm):
         return mpi4jax.alltoall(x, token=token, comm=comm)
 
 
+def mpi_sendrecv_jax(
+    x: Array, *, source: int, dest: int, token: Token = None, comm=MPI_jax_comm
+) -> tuple[jax.Array, Token]:
+    """
+    Sends `x` to the rank `dest` and receives an array with the same shape and
+    dtype from the rank `source`.
+
+    Args:
+        x: The array to send.
+        source: The rank to receive from.
+        dest: The rank to send to.
+        token: An optional token to impose ordering of MPI operations
+
+    Returns:
+        out: The received array.
+        token: an output token
+    """
+    if n_nodes == 1:
+        return x, token
+    else:
+        import mpi4jax
+
+        return mpi4jax.sendrecv(x, x, source, dest, token=token, comm=comm)
+
+
 @promote_to_pytree
 def mpi_reduce_sum_jax(x, *, token=None, root: int = 0, comm=MPI_jax_comm):
     if n_nodes == 1:
@@ -0,0 +1,42 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numba
+
+from .config_flags import config
+
+
+def numba_num_threads() -> int:
+    """
+    Returns the number of threads used by the multithreaded numba kernels, as set
+    by the `NETKET_NUMBA_NUM_THREADS` flag and capped to the number of threads
+    available to numba.
+    """
+    n_available = numba.config.NUMBA_NUM_THREADS
+    n_threads = config.netket_numba_num_threads
+    if n_threads <= 0:
+        return n_available
+    return min(n_threads, n_available)
+
+
+def use_parallel_kernels() -> bool:
+    """
+    Returns True if the multithreaded numba kernels should be used, in which
+    case it also sets the number of threads used by numba in the calling thread.
+    """
+    n_threads = numba_num_threads()
+    if n_threads > 1:
+        numba.set_num_threads(n_threads)
+        return True
+    return False
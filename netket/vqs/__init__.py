@@ -20,7 +20,13 @@ from .base import (
     expect_and_forces,
 )
 
-from .mc import MCState, MCMixedState, get_local_kernel_arguments, get_local_kernel
+from .mc import (
+    MCState,
+    MCMixedState,
+    SamplingController,
+    get_local_kernel_arguments,
+    get_local_kernel,
+)
 from .full_summ import FullSumState
 
 _deprecations = {
@@ -0,0 +1,394 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Distributed exact summation.
+#
+# Every MPI rank (or every device, when running with sharding) only holds a
+# contiguous block of the basis states. Instead of computing O @ Ψ, which
+# needs the connected states of all the basis states, the expectation values
+# are computed as exact averages of local estimators
+#
+#     <O> = Σ_x p(x) O_loc(x),    O_loc(x) = Σ_x' <x|O|x'> ψ(x')/ψ(x),
+#
+# where the model is evaluated only on the local block. The block owning a
+# connected state x' is found from its index as `number // block_size`, and
+# every block receives from the others only the log-amplitudes of the distinct
+# connected states it needs (its halo). The exchange is performed in steps: at
+# step k every block requests the halo owned by the block k positions ahead
+# and serves the one requested by the block k positions behind, so that every
+# rank holds its own block and its halo, but never the full wavefunction.
+
+import math
+from functools import partial
+from collections.abc import Callable
+
+import numpy as np
+
+import jax
+from jax import numpy as jnp
+from jax.experimental.shard_map import shard_map
+from jax.sharding import Mesh, NamedSharding, PartitionSpec as P
+
+from netket import config
+from netket import jax as nkjax
+from netket.operator import DiscreteOperator, DiscreteJaxOperator, Squared
+from netket.stats import Stats
+from netket.utils import mpi
+from netket.utils.types import PyTree
+
+
+def _block_layout(hilbert) -> tuple[int, int]:
+    # The number of blocks of basis states and their (padded) size.
+    if config.netket_experimental_sharding:
+        n_blocks = jax.device_count()
+    else:
+        n_blocks = mpi.n_nodes
+    return n_blocks, math.ceil(hilbert.n_states / n_blocks)
+
+
+@partial(jax.jit, static_argnums=(0, 1))
+def _sharded_basis_states(hilbert, n_padded):
+    numbers = nkjax.sharding.shard_along_axis(jnp.arange(n_padded), axis=0)
+    mask = numbers < hilbert.n_states
+    σ = hilbert.numbers_to_states(jnp.where(mask, numbers, 0))
+    return nkjax.sharding.shard_along_axis(σ, axis=0), mask
+
+
+def local_basis_states(hilbert) -> tuple[jax.Array, jax.Array]:
+    """
+    Returns the block of basis states of `hilbert` assigned to this rank, padded
+    to the same length on all ranks, together with a boolean mask that is False
+    for padding states.
+
+    When running with sharding, returns all states sharded along the devices.
+    """
+    n_blocks, block_size = _block_layout(hilbert)
+
+    if config.netket_experimental_sharding:
+        return _sharded_basis_states(hilbert, n_blocks * block_size)
+
+    numbers = np.arange(mpi.rank * block_size, (mpi.rank + 1) * block_size)
+    mask = numbers < hilbert.n_states
+    σ = hilbert.numbers_to_states(np.where(mask, numbers, 0))
+    return jnp.asarray(σ), jnp.asarray(mask)
+
+
+def _local_connected_elements(
+    hilbert, Ô: DiscreteOperator, σ: jax.Array, chunk_size: int | None
+):
+    # Returns the indices of the states connected to the local block of basis
+    # states and the corresponding matrix elements.
+    if isinstance(Ô, Squared):
+        Ô = Ô.parent
+
+    if isinstance(Ô, DiscreteJaxOperator):
+        return _jax_connected_elements(hilbert, Ô, σ, chunk_size)
+
+    σp, mels = Ô.get_conn_padded(np.asarray(σ))
+    numbers = hilbert.states_to_numbers(σp)
+    return jax.tree_util.tree_map(
+        partial(nkjax.sharding.shard_along_axis, axis=0), (numbers, jnp.asarray(mels))
+    )
+
+
+@partial(jax.jit, static_argnums=(0, 3))
+def _jax_connected_elements(hilbert, Ô, σ, chunk_size):
+    def _connected_elements(σ):
+        σp, mels = Ô.get_conn_padded(σ)
+        return hilbert.states_to_numbers(σp), mels
+
+    if chunk_size is not None:
+        return nkjax.apply_chunked(
+            _connected_elements, in_axes=0, chunk_size=chunk_size
+        )(σ)
+    return _connected_elements(σ)
+
+
+def _halo_requests(numbers, block, block_size, n_blocks):
+    """
+    Finds the distinct connected states of a block and their owners.
+
+    Args:
+        numbers: the indices of the states connected to the states of `block`.
+        block: the index of the block.
+        block_size: the number of basis states in every block.
+        n_blocks: the number of blocks.
+
+    Returns:
+        The sorted distinct indices, the position of every element of `numbers`
+        among them, the shift `(owner - block) % n_blocks` of their owners and
+        the number of distinct states to request at every shift.
+    """
+    numbers = np.asarray(numbers)
+    unique, inverse = np.unique(numbers, return_inverse=True)
+    shift = (unique // block_size - block) % n_blocks
+    counts = np.bincount(shift, minlength=n_blocks)
+    return unique, inverse.reshape(numbers.shape), shift, counts
+
+
+def _halo_plan(unique, inverse, shift, halo_sizes, block_size):
+    """
+    Lays out the halo of a block, given the output of :func:`_halo_requests`
+    and the size of the buffer exchanged at every shift, equal on all blocks.
+
+    The log-amplitudes of the block (`halo_sizes[0] == block_size`) are
+    followed by the buffers received at every shift with a non-zero size.
+
+    Returns:
+        The concatenated local indices to request at every shift, and the
+        position of every connected state in the halo.
+    """
+    halo_sizes = np.asarray(halo_sizes)
+    offsets = np.cumsum(halo_sizes) - halo_sizes
+    counts = np.bincount(shift, minlength=len(halo_sizes))
+
+    # index of every distinct state among those with the same shift
+    slot = np.empty_like(shift)
+    slot[np.argsort(shift, kind="stable")] = np.arange(len(unique)) - np.repeat(
+        np.cumsum(counts) - counts, counts
+    )
+    local_index = unique % block_size
+    slot = np.where(shift == 0, local_index, slot)
+
+    position = offsets[shift] + slot
+    requests = np.zeros(offsets[-1] + halo_sizes[-1] - block_size, dtype=np.int32)
+    remote = shift > 0
+    requests[position[remote] - block_size] = local_index[remote]
+    return requests, position[inverse].astype(np.int32)
+
+
+def _connected_halo(hilbert, Ô: DiscreteOperator, σ: jax.Array, chunk_size):
+    # Returns the static sizes of the buffers exchanged at every shift, and the
+    # local requests, positions in the halo and matrix elements of the
+    # connected states of the local block.
+    n_blocks, block_size = _block_layout(hilbert)
+    numbers, mels = _local_connected_elements(hilbert, Ô, σ, chunk_size)
+
+    if config.netket_experimental_sharding:
+        numbers = nkjax.sharding.shard_along_axis(numbers, axis=0)
+        shards = list(numbers.addressable_shards)
+        blocks = [(s.index[0].start or 0) // block_size for s in shards]
+        halos = [
+            _halo_requests(s.data, b, block_size, n_blocks)
+            for s, b in zip(shards, blocks)
+        ]
+        counts = np.max([h[3] for h in halos], axis=0)
+        if jax.process_count() > 1:
+            from jax.experimental import multihost_utils
+
+            counts = multihost_utils.process_allgather(counts).max(axis=0)
+    else:
+        halos = [_halo_requests(numbers, mpi.rank, block_size, n_blocks)]
+        counts = mpi.mpi_max(halos[0][3])
+    # the block itself is not exchanged, and is read from its log-amplitudes
+    halo_sizes = (block_size,) + tuple(int(c) for c in counts[1:])
+
+    plans = [_halo_plan(u, i, s, halo_sizes, block_size) for u, i, s, _ in halos]
+
+    if config.netket_experimental_sharding:
+        sharding = NamedSharding(Mesh(jax.devices(), axis_names=("i",)), P("i"))
+        devices = [s.device for s in shards]
+        requests, positions = (
+            jax.make_array_from_single_device_arrays(
+                (n_blocks * len(plans[0][k]),) + plans[0][k].shape[1:],
+                sharding,
+                [jax.device_put(p[k], d) for p, d in zip(plans, devices)],
+            )
+            for k in range(2)
+        )
+    else:
+        requests, positions = (jnp.asarray(x) for x in plans[0])
+    return halo_sizes, (requests, positions, mels)
+
+
+def _exchange_halo(halo_sizes, log_psi, requests, positions, send_recv):
+    # Returns the log-amplitudes of the connected states of a block. At every
+    # shift k the block sends its requests to the block k positions ahead,
+    # serves the requests of the block k positions behind, and receives the
+    # requested log-amplitudes back.
+    halo = [log_psi]
+    offset = 0
+    for k, size in enumerate(halo_sizes):
+        if k == 0 or size == 0:
+            continue
+        served = send_recv(requests[offset : offset + size], k)
+        halo.append(send_recv(log_psi[served], -k))
+        offset += size
+    return jnp.concatenate(halo)[positions]
+
+
+def _connected_log_psi(halo_sizes, log_psi, requests, positions):
+    n_blocks = len(halo_sizes)
+
+    if config.netket_experimental_sharding:
+
+        def send_recv(x, k):
+            perm = [(j, (j + k) % n_blocks) for j in range(n_blocks)]
+            return jax.lax.ppermute(x, "i", perm)
+
+        return shard_map(
+            partial(_exchange_halo, halo_sizes, send_recv=send_recv),
+            mesh=Mesh(jax.devices(), axis_names=("i",)),
+            in_specs=(P("i"), P("i"), P("i")),
+            out_specs=P("i"),
+            check_rep=False,
+        )(log_psi, requests, positions)
+
+    def send_recv(x, k):
+        source, dest = (mpi.rank - k) % n_blocks, (mpi.rank + k) % n_blocks
+        return mpi.mpi_sendrecv_jax(x, source=source, dest=dest)[0]
+
+    return _exchange_halo(halo_sizes, log_psi, requests, positions, send_recv)
+
+
+def _mpi_sum(x):
+    return mpi.mpi_sum_jax(x)[0]
+
+
+def _local_statistics(
+    squared: bool,
+    halo_sizes: tuple[int, ...],
+    model_apply_fun: Callable,
+    chunk_size: int | None,
+    variables: PyTree,
+    σ: jax.Array,
+    mask: jax.Array,
+    conn: tuple[jax.Array, jax.Array, jax.Array],
+):
+    # Returns the statistics of the local estimator, the normalized probabilities
+    # and the local estimators of the states in σ.
+    if chunk_size is not None:
+        log_psi = nkjax.apply_chunked(
+            model_apply_fun, in_axes=(None, 0), chunk_size=chunk_size
+        )(variables, σ)
+    else:
+        log_psi = model_apply_fun(variables, σ)
+
+    log_p = jnp.where(mask, 2 * log_psi.real, -jnp.inf)
+    log_p_max = mpi.mpi_max_jax(log_p.max())[0]
+    p = jnp.exp(log_p - log_p_max)
+    p = p / _mpi_sum(p.sum())
+
+    requests, positions, mels = conn
+    log_psi_conn = _connected_log_psi(halo_sizes, log_psi, requests, positions)
+    O_loc = jnp.sum(
+        mels * jnp.exp(log_psi_conn - jnp.expand_dims(log_psi, -1)), axis=-1
+    )
+    if squared:
+        O_loc = jnp.abs(O_loc) ** 2
+    # states with zero amplitude (and padding) do not contribute
+    O_loc = jnp.where(p > 0, O_loc, 0)
+
+    O_mean = _mpi_sum(jnp.sum(p * O_loc))
+    variance = _mpi_sum(jnp.sum(p * jnp.abs(O_loc - O_mean) ** 2))
+    stats = Stats(mean=O_mean, error_of_mean=0.0, variance=variance)
+    return stats, p, O_loc
+
+
+@partial(jax.jit, static_argnums=(0, 1, 2, 3))
+def _expect_kernel(
+    squared, halo_sizes, model_apply_fun, chunk_size, variables, σ, mask, conn
+):
+    return _local_statistics(
+        squared, halo_sizes, model_apply_fun, chunk_size, variables, σ, mask, conn
+    )[0]
+
+
+@partial(jax.jit, static_argnums=(0, 1, 2, 3))
+def _expect_and_forces_kernel(
+    squared,
+    halo_sizes,
+    model_apply_fun,
+    chunk_size,
+    parameters,
+    model_state,
+    σ,
+    mask,
+    conn,
+):
+    variables = {"params": parameters, **model_state}
+    stats, p, O_loc = _local_statistics(
+        squared, halo_sizes, model_apply_fun, chunk_size, variables, σ, mask, conn
+    )
+
+    # Equivalent to (OΨ - <O>Ψ)^* Ψ in the non distributed implementation
+    ΔO = p * (O_loc - stats.mean).conj()
+
+    if chunk_size is None:
+        _, vjp_fun = nkjax.vjp(
+            lambda w: model_apply_fun({"params": w, **model_state}, σ),
+            parameters,
+            conjugate=True,
+        )
+        O_grad = vjp_fun(ΔO)[0]
+    else:
+        vjp_fun = nkjax.vjp_chunked(
+            lambda w, σ: model_apply_fun({"params": w, **model_state}, σ),
+            parameters,
+            σ,
+            conjugate=True,
+            chunk_size=chunk_size,
+            chunk_argnums=1,
+            nondiff_argnums=1,
+        )
+        O_grad = vjp_fun(ΔO)[0]
+
+    O_grad = jax.tree_util.tree_map(_mpi_sum, O_grad)
+    return stats, O_grad
+
+
+def expect_distributed(vstate, Ô: DiscreteOperator) -> Stats:
+    """
+    Computes the expectation value of `Ô` over a distributed
+    :class:`~netket.vqs.FullSumState`.
+    """
+    σ, mask = vstate._local_states
+    halo_sizes, conn = _connected_halo(vstate.hilbert, Ô, σ, vstate.chunk_size)
+    return _expect_kernel(
+        isinstance(Ô, Squared),
+        halo_sizes,
+        vstate._apply_fun,
+        vstate.chunk_size,
+        vstate.variables,
+        σ,
+        mask,
+        conn,
+    )
+
+
+def expect_and_forces_distributed(
+    vstate, Ô: DiscreteOperator, *, mutable=False
+) -> tuple[Stats, PyTree]:
+    """
+    Computes the expectation value of `Ô` and the corresponding forces over a
+    distributed :class:`~netket.vqs.FullSumState`.
+    """
+    if mutable is not False:
+        raise NotImplementedError(
+            "Mutable model state is not supported by distributed FullSumState."
+        )
+
+    σ, mask = vstate._local_states
+    halo_sizes, conn = _connected_halo(vstate.hilbert, Ô, σ, vstate.chunk_size)
+    return _expect_and_forces_kernel(
+        isinstance(Ô, Squared),
+        halo_sizes,
+        vstate._apply_fun,
+        vstate.chunk_size,
+        vstate.parameters,
+        vstate.model_state,
+        σ,
+        mask,
+        conn,
+    )
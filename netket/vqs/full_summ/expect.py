@@ -29,6 +29,7 @@ from netket.vqs import expect_and_grad, expect_and_forces
 from netket.vqs.mc.common import force_to_grad
 
 from .state import FullSumState
+from .distributed import expect_distributed, expect_and_forces_distributed
 
 
 def _check_hilbert(A, B):
@@ -52,6 +53,9 @@ def sparsify(Ô):
 def expect(vstate: FullSumState, Ô: DiscreteOperator) -> Stats:  # noqa: F811
     _check_hilbert(vstate, Ô)
 
+    if vstate.distributed:
+        return expect_distributed(vstate, Ô)
+
     O = sparsify(Ô)
     Ψ = vstate.to_array()
 
@@ -104,6 +108,9 @@ def expect_and_forces_fullsum(
 
     _check_hilbert(vstate, Ô)
 
+    if vstate.distributed:
+        return expect_and_forces_distributed(vstate, Ô, mutable=mutable)
+
     O = sparsify(Ô)
     Ψ = vstate.to_array()
     OΨ = O @ Ψ
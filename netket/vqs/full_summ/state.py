@@ -38,7 +38,7 @@ from netket.optimizer import LinearOperator
 from netket.optimizer.qgt import QGTAuto
 
 from ..base import VariationalState, QGTConstructor
-from ..mc.mc_state.state import check_chunk_size, _is_power_of_two
+from ..mc.mc_state.state import _is_power_of_two
 
 
 @partial(jax.jit, static_argnums=0)
@@ -75,12 +75,15 @@ class FullSumState(VariationalState):
 
     _chunk_size: int | None = None
 
+    _distributed: bool = False
+
     def __init__(
         self,
         hilbert: DiscreteHilbert,
         model=None,
         *,
         chunk_size: int | None = None,
+        distributed: bool = False,
         variables: PyTree | None = None,
         init_fun: NNInitFunc | None = None,
         apply_fun: Callable | None = None,
@@ -110,6 +113,13 @@ class FullSumState(VariationalState):
             chunk_size: (Defaults to `None`) If specified, calculations are split into chunks where the neural network
                 is evaluated at most on :code:`chunk_size` samples at once. This does not change the mathematical results,
                 but will trade a higher computational cost for lower memory cost.
+            distributed: (Defaults to `False`) If True, the basis states are split among
+                MPI ranks (or devices, when running with sharding) and expectation values
+                and gradients are computed as exact averages of local estimators. The
+                model is evaluated only on the states of every rank, and every rank
+                receives from the others only the log-amplitudes of the connected
+                states it needs, so that it never holds the full wavefunction.
+                Methods such as :meth:`to_array` still gather the full wavefunction.
         """
         super().__init__(hilbert)
         self._model_framework = None
@@ -181,6 +191,11 @@ class FullSumState(VariationalState):
         Caches the output of `self._all_states()`.
         """
 
+        self._local_states_cache = None
+        """
+        Caches the output of `self._local_states`.
+        """
+
         self._array = None
         """
         Caches the output of `self.to_array()`.
@@ -192,6 +207,7 @@ class FullSumState(VariationalState):
         """
 
         self.chunk_size = chunk_size
+        self._distributed = distributed
 
     def init(self, seed=None, dtype=None):
         """
@@ -224,6 +240,15 @@ class FullSumState(VariationalState):
         """
         return self._hilbert  # type: ignore
 
+    @property
+    def distributed(self) -> bool:
+        """
+        Whether expectation values and gradients are computed without ever
+        gathering all the basis states and their connected states on a single rank.
+        See the `distributed` argument of the constructor.
+        """
+        return self._distributed
+
     @property
     def chunk_size(self) -> int | None:
         """
@@ -262,9 +287,6 @@ class FullSumState(VariationalState):
                 "For performance reasons, we suggest to use a power-of-two chunk size."
             )
 
-        # TODO MPI aware check for valid size
-        check_chunk_size(self.hilbert.n_states, chunk_size)
-
         self._chunk_size = chunk_size
 
     def reset(self):
@@ -361,6 +383,15 @@ class FullSumState(VariationalState):
             self._states = self.hilbert.all_states()
         return self._states
 
+    @property
+    def _local_states(self):
+        # the block of basis states handled by this rank, and the padding mask
+        if self._local_states_cache is None:
+            from .distributed import local_basis_states
+
+            self._local_states_cache = local_basis_states(self.hilbert)
+        return self._local_states_cache
+
     def __repr__(self):
         return (
             "FullSumState("
@@ -27,5 +27,5 @@ expect/expect_and_grad methods.
 
 from .common import check_hilbert, get_local_kernel_arguments, get_local_kernel
 
-from .mc_state import MCState
+from .mc_state import MCState, SamplingController
 from .mc_mixed_state import MCMixedState
@@ -19,12 +19,22 @@ This module implements some common kernels used by MCState and MCMixedState.
 from collections.abc import Callable
 from functools import partial
 
+import numpy as np
+
 import jax
 import jax.numpy as jnp
 
 from netket.utils.types import PyTree, Array
 import netket.jax as nkjax
-from netket.operator import DiscreteJaxOperator
+from netket.operator import (
+    DiscreteJaxOperator,
+    BoseHubbardJax,
+    FermionOperator2ndJax,
+    IsingJax,
+    LocalOperatorJax,
+    PauliStringsJax,
+    SumOperatorJax,
+)
 
 
 def batch_discrete_kernel(kernel):
@@ -65,13 +75,133 @@ def local_value_kernel_jax(
 ):
     """
     local_value kernel for MCState for jax-compatible operators
+
+    The diagonal matrix elements are returned separately by the operator when
+    possible, so that logpsi is not evaluated on σ a second time.
     """
-    σp, mel = O.get_conn_padded(σ)
+    mel_diag, σp, mel = O.get_conn_padded_offdiagonal(σ)
     logpsi_σ = logpsi(pars, σ)
     logpsi_σp = logpsi(pars, σp.reshape(-1, σp.shape[-1])).reshape(σp.shape[:-1])
+    return mel_diag + jnp.sum(
+        mel * jnp.exp(logpsi_σp - jnp.expand_dims(logpsi_σ, -1)), axis=-1
+    )
+
+
+def _apply_unique(f: Callable, x: Array, max_unique: int) -> Array:
+    """
+    Computes `f(x)` on a batch of configurations `x` of shape `(n, N)`,
+    evaluating `f` only once for every distinct row of `x`.
+
+    The distinct rows are found by sorting `x` lexicographically, and are
+    stored in a buffer of static size `max_unique`. If `x` contains more
+    than `max_unique` distinct rows, `f` is evaluated on the full `x` instead.
+    """
+    n = x.shape[0]
+
+    perm = jnp.lexsort(list(x.T)[::-1])
+    x_sorted = x[perm]
+    is_new = jnp.concatenate(
+        [jnp.ones((1,), dtype=bool), jnp.any(x_sorted[1:] != x_sorted[:-1], axis=-1)]
+    )
+    # index of the distinct configuration of every row
+    group = jnp.cumsum(is_new) - 1
+    n_unique = group[-1] + 1
+    inverse = jnp.zeros(n, dtype=group.dtype).at[perm].set(group)
+
+    def _f_unique(x):
+        # unused entries of the buffer are filled with a valid configuration
+        x_unique = jnp.broadcast_to(x_sorted[0], (max_unique, x.shape[-1]))
+        x_unique = x_unique.at[group].set(x_sorted, mode="drop")
+        return f(x_unique)[inverse]
+
+    return jax.lax.cond(n_unique <= max_unique, _f_unique, f, x)
+
+
+def local_value_kernel_jax_unique(
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    unique_fraction: float = 0.5,
+):
+    """
+    local_value kernel for MCState for jax-compatible operators, evaluating
+    logpsi only once for every distinct configuration among the samples σ
+    and their connected configurations σp.
+
+    The distinct configurations are evaluated in a buffer holding a fraction
+    `unique_fraction` of all configurations, so that logpsi is evaluated on
+    `1/unique_fraction` times fewer configurations. If there are more distinct
+    configurations than that, all configurations are evaluated as in
+    :func:`local_value_kernel_jax`, after the cost of sorting them.
+    """
+    σp, mel = O.get_conn_padded(σ)
+    N = σ.shape[-1]
+    n_samples = σ.size // N
+
+    σ_all = jnp.concatenate([σ.reshape(-1, N), σp.reshape(-1, N)], axis=0)
+    max_unique = max(1, int(σ_all.shape[0] * unique_fraction))
+    logpsi_all = _apply_unique(partial(logpsi, pars), σ_all, max_unique)
+
+    logpsi_σ = logpsi_all[:n_samples].reshape(σ.shape[:-1])
+    logpsi_σp = logpsi_all[n_samples:].reshape(σp.shape[:-1])
     return jnp.sum(mel * jnp.exp(logpsi_σp - jnp.expand_dims(logpsi_σ, -1)), axis=-1)
 
 
+def _apply_masked(f: Callable, x: Array, mask: Array, n_buffers: int = 4) -> Array:
+    """
+    Computes `f(x)` on the rows of a batch of configurations `x` of shape
+    `(n, N)` where `mask` is True. The value of the other rows is arbitrary
+    (but finite if `f` is).
+
+    The selected rows are moved to the front of a buffer, which is the smallest
+    among `n_buffers` static sizes `n, n/2, n/4, ...` holding all of them, so
+    that `f` is evaluated on at most twice as many configurations as selected
+    (or on all of them if more than half are selected).
+    """
+    n = x.shape[0]
+    position = jnp.cumsum(mask) - 1
+    n_selected = position[-1] + 1
+    sizes = sorted({max(1, n >> k) for k in range(n_buffers)})
+
+    def _f_buffer(size):
+        def _f(x):
+            # unused entries of the buffer are filled with a valid configuration
+            buffer = jnp.broadcast_to(x[0], (size, x.shape[-1]))
+            buffer = buffer.at[jnp.where(mask, position, size)].set(x, mode="drop")
+            return f(buffer)[jnp.clip(position, 0, size - 1)]
+
+        return _f
+
+    branch = jnp.searchsorted(jnp.asarray(sizes), n_selected)
+    return jax.lax.switch(branch, [_f_buffer(size) for size in sizes], x)
+
+
+def local_value_kernel_jax_nonzero(
+    logpsi: Callable, pars: PyTree, σ: Array, O: DiscreteJaxOperator
+):
+    """
+    local_value kernel for MCState for jax-compatible operators whose padded
+    connected elements contain many zero matrix elements, such as
+    :class:`~netket.operator.SumOperatorJax`, where the connected states
+    appearing in several terms are merged. logpsi is only evaluated on the
+    connected configurations with a non-zero matrix element.
+    """
+    mel_diag, σp, mel = O.get_conn_padded_offdiagonal(σ)
+    N = σ.shape[-1]
+    nonzero = mel != 0
+
+    logpsi_σ = logpsi(pars, σ)
+    logpsi_σp = _apply_masked(
+        partial(logpsi, pars), σp.reshape(-1, N), nonzero.reshape(-1)
+    ).reshape(σp.shape[:-1])
+    return mel_diag + jnp.sum(
+        jnp.where(nonzero, mel * jnp.exp(logpsi_σp - logpsi_σ[..., None]), 0),
+        axis=-1,
+    )
+
+
 def local_value_kernel_jax_conn_chunked(
     logpsi: Callable,
     pars: PyTree,
@@ -85,12 +215,14 @@ def local_value_kernel_jax_conn_chunked(
     apply_conn = lambda s: logpsi(pars, s)
     apply_conn = nkjax.apply_chunked(apply_conn, in_axes=0, chunk_size=chunk_size)
 
-    σp, mel = O.get_conn_padded(σ)
+    mel_diag, σp, mel = O.get_conn_padded_offdiagonal(σ)
 
     logpsi_σ = apply_conn(σ)
     logpsi_σp = apply_conn(σp.reshape(-1, σ.shape[-1])).reshape(σp.shape[:-1])
 
-    return jnp.sum(mel * jnp.exp(logpsi_σp - jnp.expand_dims(logpsi_σ, -1)), axis=-1)
+    return mel_diag + jnp.sum(
+        mel * jnp.exp(logpsi_σp - jnp.expand_dims(logpsi_σ, -1)), axis=-1
+    )
 
 
 def local_value_squared_kernel(logpsi: Callable, pars: PyTree, σ: Array, args: PyTree):
@@ -217,3 +349,428 @@ def local_value_kernel_jax_chunked(
         )
 
     return local_value_chunked(σ)
+
+
+def local_value_kernel_jax_unique_chunked(
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    chunk_size: int | None = None,
+    unique_fraction: float = 0.5,
+):
+    """
+    local_value kernel for MCState and jax-compatible operators, deduplicating
+    the configurations within every chunk of samples.
+    """
+    if chunk_size < O.max_conn_size:
+        return local_value_kernel_jax_chunked(
+            logpsi, pars, σ, O, chunk_size=chunk_size
+        )
+
+    local_value_kernel = lambda s: local_value_kernel_jax_unique(
+        logpsi, pars, s, O, unique_fraction=unique_fraction
+    )
+    local_value_chunked = nkjax.apply_chunked(
+        local_value_kernel,
+        in_axes=0,
+        chunk_size=max(1, chunk_size // O.max_conn_size),
+    )
+    return local_value_chunked(σ)
+
+
+def local_value_kernel_jax_nonzero_chunked(
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    chunk_size: int | None = None,
+):
+    """
+    local_value kernel for MCState and jax-compatible operators, evaluating
+    logpsi only on the connected configurations with a non-zero matrix element
+    within every chunk of samples.
+    """
+    if chunk_size < O.max_conn_size:
+        return local_value_kernel_jax_chunked(
+            logpsi, pars, σ, O, chunk_size=chunk_size
+        )
+
+    local_value_kernel = lambda s: local_value_kernel_jax_nonzero(logpsi, pars, s, O)
+    local_value_chunked = nkjax.apply_chunked(
+        local_value_kernel,
+        in_axes=0,
+        chunk_size=max(1, chunk_size // O.max_conn_size),
+    )
+    return local_value_chunked(σ)
+
+
+def _as_variables(pars):
+    # the kernels are called either with the parameters or with all the variables
+    return pars if "params" in pars else {"params": pars}
+
+
+def _operator_sites(O: DiscreteJaxOperator) -> list[tuple[int, ...]] | None:
+    # The sites on which every term of `O` can change the configuration, or None
+    # if they are not known for this type of operator.
+    if isinstance(O, SumOperatorJax):
+        sites = [_operator_sites(op) for op in O.operators]
+        if any(s is None for s in sites):
+            return None
+        return [t for s in sites for t in s]
+    if isinstance(O, LocalOperatorJax):
+        return [tuple(a) for a in O.acting_on]
+    if isinstance(O, PauliStringsJax):
+        return [tuple(i for i, c in enumerate(s) if c in "XY") for s in O.operators]
+    if isinstance(O, IsingJax):
+        return [(i,) for i in range(O.hilbert.size)]
+    if isinstance(O, BoseHubbardJax):
+        return [tuple(e) for e in np.asarray(O.edges)]
+    if isinstance(O, FermionOperator2ndJax):
+        return [tuple(orb for orb, _ in term) for term in O.terms]
+    return None
+
+
+def _sites_span(sites, N, periodic):
+    # Number of consecutive sites (cyclically if periodic) covering `sites`
+    sites = np.unique(np.asarray(sites, dtype=int))
+    if not periodic:
+        return int(sites[-1] - sites[0] + 1)
+    gaps = np.diff(np.append(sites, sites[0] + N))
+    return int(N - gaps.max() + 1)
+
+
+def mps_local_value_window(model, O: DiscreteJaxOperator) -> int | None:
+    """
+    Returns the number of consecutive sites, cyclically for periodic boundary
+    conditions, covering the sites on which any term of `O` acts, to be used as
+    the `window` of :func:`local_value_kernel_jax_mps` for the Matrix Product
+    State `model`.
+
+    Returns None if those sites are not known for the type of `O`, or if the
+    window is too large for :func:`local_value_kernel_jax_mps` to be used, which
+    is the case for windows larger than half of the chain with periodic boundary
+    conditions.
+    """
+    from netket.models.tensor_networks import MPSOpen
+
+    sites = _operator_sites(O)
+    if sites is None:
+        return None
+
+    N = O.hilbert.size
+    periodic = not isinstance(model, MPSOpen)
+    window = max((_sites_span(s, N, periodic) for s in sites if len(s) > 0), default=1)
+    max_window = N // 2 if periodic else N - 1
+    return window if window <= max_window else None
+
+
+def _mps_local_value(tensors, qn, qn_p, mel, *, periodic, window):
+    """
+    Local value of a single configuration, given the local indices `qn` of the
+    configuration and `qn_p` of the connected ones, for a Matrix Product State
+    :math:`\\Psi(s) = \\mathrm{Tr}[A[s_1]\\dots A[s_N]]`.
+
+    The left and right environments of the configuration are computed once, so
+    that the amplitude of every connected configuration is obtained by
+    contracting only `window` sites around those where it differs from `qn`,
+    which must all fit in the window.
+
+    For periodic boundary conditions, the environments are also computed for the
+    chain rotated by `N // 2` sites, which leaves the trace unchanged, so that any
+    `window` of at most `N // 2` consecutive sites across the boundary of the
+    chain is contiguous in one of the two orderings of the sites.
+    """
+    N, _, D, _ = tensors.shape
+    A = tensors[jnp.arange(N), qn]
+    shifts = (0, N // 2) if periodic else (0,)
+
+    # for open boundary conditions the boundary tensors only have their first
+    # row (left) or column (right) set, so the edges can be vectors.
+    if periodic:
+        edge = jnp.eye(D, dtype=tensors.dtype)
+    else:
+        edge = jnp.zeros((D,), dtype=tensors.dtype).at[0].set(1)
+
+    def _contract(left, right):
+        return jnp.sum(left * right.T)
+
+    def _left_step(left, A):
+        left = left @ A
+        return left, left
+
+    def _right_step(right, A):
+        right = A @ right
+        return right, right
+
+    def _environments(A):
+        # lefts[i] contracts the sites 0...i-1, rights[i] the sites i...N-1
+        _, lefts = jax.lax.scan(_left_step, edge, A)
+        lefts = jnp.concatenate([edge[None], lefts])
+        _, rights = jax.lax.scan(_right_step, edge, A[::-1])
+        rights = jnp.concatenate([rights[::-1], edge[None]])
+        return lefts, rights
+
+    lefts, rights = jax.tree_util.tree_map(
+        lambda *x: jnp.stack(x),
+        *[_environments(jnp.roll(A, -shift, axis=0)) for shift in shifts],
+    )
+
+    def _amplitude(qn_p):
+        # the ordering of the sites in which the differing ones are closest
+        diff = jnp.stack([jnp.roll(qn_p != qn, -shift) for shift in shifts])
+        first = jnp.argmax(diff, axis=-1)
+        last = N - 1 - jnp.argmax(diff[:, ::-1], axis=-1)
+        r = jnp.argmin(last - first)
+
+        start = jnp.minimum(first[r], N - window)
+        sites = (start + jnp.asarray(shifts)[r] + jnp.arange(window)) % N
+        left, _ = jax.lax.scan(_left_step, lefts[r, start], tensors[sites, qn_p[sites]])
+        return _contract(left, rights[r, start + window])
+
+    dtype = nkjax.dtype_complex(tensors.dtype)
+    ψ = _contract(lefts[0, N], edge).astype(dtype)
+    ψ_p = jax.vmap(_amplitude)(qn_p).astype(dtype)
+    return jnp.sum(mel * ψ_p / ψ)
+
+
+def local_value_kernel_jax_mps(
+    model,
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    window: int,
+):
+    """
+    local_value kernel for MCState of Matrix Product States and jax-compatible
+    operators.
+
+    The model must expose a method `site_tensors`, as
+    :class:`~netket.models.tensor_networks.MPSOpen` and
+    :class:`~netket.models.tensor_networks.MPSPeriodic` do.
+
+    Every connected configuration is contracted only on `window` consecutive
+    sites covering those where it differs from the sample, using the left and
+    right environments of the sample. For an operator with :math:`M` connected
+    configurations, this costs :math:`O((N + M\\cdot\\text{window})\\chi^2)` per
+    sample for open boundary conditions instead of :math:`O(MN\\chi^2)`.
+
+    The window must cover the sites on which any term of the operator acts, as
+    returned by :func:`mps_local_value_window`, such that every connected
+    configuration fits in it.
+    """
+    from netket.models.tensor_networks import MPSOpen
+
+    σp, mel = O.get_conn_padded(σ)
+    N = σ.shape[-1]
+
+    qn = model.hilbert.states_to_local_indices(σ.reshape(-1, N))
+    qn_p = model.hilbert.states_to_local_indices(σp.reshape(qn.shape[0], -1, N))
+    mel = mel.reshape(qn_p.shape[:-1])
+
+    tensors = model.apply(_as_variables(pars), method=model.site_tensors)
+    kernel = partial(
+        _mps_local_value, periodic=not isinstance(model, MPSOpen), window=window
+    )
+    O_loc = jax.vmap(kernel, in_axes=(None, 0, 0, 0))(tensors, qn, qn_p, mel)
+    return O_loc.reshape(σ.shape[:-1])
+
+
+def local_value_kernel_jax_mps_chunked(
+    model,
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    window: int,
+    chunk_size: int | None = None,
+):
+    """
+    local_value kernel for MCState of Matrix Product States and jax-compatible
+    operators, computing the local values of the samples in chunks.
+    """
+    local_value_kernel = lambda s: local_value_kernel_jax_mps(
+        model, logpsi, pars, s, O, window=window
+    )
+    local_value_chunked = nkjax.apply_chunked(
+        local_value_kernel,
+        in_axes=0,
+        chunk_size=max(1, chunk_size // O.max_conn_size),
+    )
+    return local_value_chunked(σ)
+
+
+def _slater_local_value(orbitals, n, n_p, mel, *, max_excitations):
+    """
+    Local value of a single configuration `n` connected to the configurations
+    `n_p`, for a sum of Slater determinants of the generalized orbitals
+    `orbitals`, of shape `(n_determinants, n_modes, n_fermions)`.
+
+    The matrices of the occupied orbitals are factorized once, and the ratio of
+    the amplitude of every connected configuration, which must differ from `n`
+    by at most `max_excitations` fermions, is obtained from the determinant lemma.
+    """
+    n_fermions = orbitals.shape[-1]
+    k = max_excitations
+
+    R = jnp.nonzero(n, size=n_fermions)[0]
+    A = orbitals[:, R, :]
+    log_dets = nkjax.logdet_cmplx(A)
+    weights = jnp.exp(log_dets - nkjax.logsumexp_cplx(log_dets))
+    # G = M A^{-1}, such that det(M[R']) / det(A) = det(G[R'])
+    G = jnp.linalg.solve(A.swapaxes(-1, -2), orbitals.swapaxes(-1, -2))
+    G = G.swapaxes(-1, -2)
+    # column of every occupied mode in A
+    col = jnp.cumsum(n) - 1
+
+    def _ratio(n_p):
+        removed = jnp.nonzero(n & ~n_p, size=k, fill_value=0)[0]
+        added = jnp.nonzero(n_p & ~n, size=k, fill_value=0)[0]
+        valid = jnp.arange(k) < jnp.sum(n & ~n_p)
+        both_valid = valid[:, None] & valid[None, :]
+        p = col[removed]
+
+        # G[R''], with R'' the modes R where the removed ones are replaced by the
+        # added ones, is the identity but on the rows p.
+        D = jnp.where(both_valid, G[:, added[:, None], p[None, :]], jnp.eye(k))
+        ratios = jnp.linalg.det(D)
+
+        # the parity of the permutation sorting R'' is that of its inversions,
+        # which all involve at least one of the replaced positions.
+        R_p = R.at[jnp.where(valid, p, n_fermions)].set(added, mode="drop")
+        q = jnp.arange(n_fermions)
+        inversions = jnp.where(
+            q[None, :] < p[:, None],
+            R_p[None, :] > added[:, None],
+            R_p[None, :] < added[:, None],
+        )
+        n_inversions = jnp.sum(inversions & valid[:, None])
+        # the inversions among two replaced positions are counted twice
+        crossed = (p[:, None] < p[None, :]) != (added[:, None] < added[None, :])
+        n_inversions = n_inversions - jnp.sum(crossed & both_valid) // 2
+        sign = 1 - 2 * (n_inversions % 2)
+
+        return sign * jnp.sum(weights * ratios)
+
+    return jnp.sum(mel * jax.vmap(_ratio)(n_p))
+
+
+def local_value_kernel_slater(
+    model,
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    args: PyTree,
+    *,
+    max_excitations: int = 2,
+):
+    """
+    local_value kernel for MCState of Slater determinants and generic operators.
+
+    The model must expose a method `generalized_orbitals`, as
+    :class:`~netket.models.Slater2nd` and :class:`~netket.models.MultiSlater2nd`
+    do.
+
+    The matrix of the occupied orbitals of every sample is factorized once in
+    :math:`O(N_f^3)`, and the amplitude ratios of the connected configurations,
+    differing by single or double excitations, are computed in :math:`O(N_f)`
+    from the determinant lemma, instead of :math:`O(N_f^3)` for every connected
+    configuration. The fermionic sign of the reordering of the occupied modes is
+    included, so that the ratios are exactly those of the model.
+
+    If any connected configuration differs from its sample by more than
+    `max_excitations` fermions, the local values of all the samples are computed
+    by :func:`local_value_kernel` instead.
+    """
+    σp, mel = args
+    N = σ.shape[-1]
+
+    n = jnp.isclose(σ.reshape(-1, N), 1)
+    n_p = jnp.isclose(σp.reshape(n.shape[0], -1, N), 1)
+    mel = mel.reshape(n_p.shape[:-1])
+
+    # the connected configurations must conserve the number of fermions
+    n_removed = jnp.sum(n[:, None] & ~n_p, axis=-1)
+    n_added = jnp.sum(n_p & ~n[:, None], axis=-1)
+    fits = jnp.all((n_removed <= max_excitations) & (n_removed == n_added))
+
+    def _lemma(pars):
+        orbitals = model.apply(_as_variables(pars), method=model.generalized_orbitals)
+        orbitals = orbitals.reshape((-1,) + orbitals.shape[-2:])
+        kernel = partial(_slater_local_value, max_excitations=max_excitations)
+        O_loc = jax.vmap(kernel, in_axes=(None, 0, 0, 0))(orbitals, n, n_p, mel)
+        return O_loc.reshape(σ.shape[:-1])
+
+    def _full(pars):
+        return local_value_kernel(logpsi, pars, σ, args)
+
+    return jax.lax.cond(fits, _lemma, _full, pars)
+
+
+def local_value_kernel_jax_slater(
+    model, logpsi: Callable, pars: PyTree, σ: Array, O: DiscreteJaxOperator
+):
+    """
+    local_value kernel for MCState of Slater determinants and jax-compatible
+    operators. See :func:`local_value_kernel_slater`.
+    """
+    return local_value_kernel_slater(model, logpsi, pars, σ, O.get_conn_padded(σ))
+
+
+def local_value_kernel_slater_chunked(
+    model,
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    args: PyTree,
+    *,
+    chunk_size: int | None = None,
+):
+    """
+    local_value kernel for MCState of Slater determinants and generic operators,
+    computing the local values of the samples in chunks.
+    """
+    σp, mels = args
+
+    if jnp.ndim(σp) != 3:
+        σp = σp.reshape((σ.shape[0], -1, σ.shape[-1]))
+        mels = mels.reshape(σp.shape[:-1])
+
+    local_value_kernel = lambda s, sp, m: local_value_kernel_slater(
+        model, logpsi, pars, s, (sp, m)
+    )
+    local_value_chunked = nkjax.apply_chunked(
+        local_value_kernel,
+        in_axes=(0, 0, 0),
+        chunk_size=max(1, chunk_size // σp.shape[1]),
+    )
+    return local_value_chunked(σ, σp, mels)
+
+
+def local_value_kernel_jax_slater_chunked(
+    model,
+    logpsi: Callable,
+    pars: PyTree,
+    σ: Array,
+    O: DiscreteJaxOperator,
+    *,
+    chunk_size: int | None = None,
+):
+    """
+    local_value kernel for MCState of Slater determinants and jax-compatible
+    operators, computing the local values of the samples in chunks.
+    """
+    local_value_kernel = lambda s: local_value_kernel_jax_slater(
+        model, logpsi, pars, s, O
+    )
+    local_value_chunked = nkjax.apply_chunked(
+        local_value_kernel,
+        in_axes=0,
+        chunk_size=max(1, chunk_size // O.max_conn_size),
+    )
+    return local_value_chunked(σ)
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from .state import MCState
+from .sampling_controller import SamplingController
 
 from . import expect
 from . import expect_grad
@@ -0,0 +1,196 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Automatic selection of the chunk size.
+#
+# The memory required by an operation is estimated by XLA when compiling it,
+# without running it. For a given operation we compile it without chunking
+# and, if it does not fit in the memory budget, with decreasing power-of-two
+# chunk sizes, extrapolating linearly from the previous estimates to skip
+# the sizes that clearly do not fit. The largest chunk size that fits is
+# used, as larger chunks are usually faster.
+#
+# Optionally, the run time of the largest chunk size that fits and of a few
+# smaller ones is measured, and the fastest is used instead, since on some
+# devices (and on CPU, where the memory is not limited) smaller chunks can be
+# faster thanks to better cache locality.
+
+import time
+import warnings
+from collections.abc import Callable
+
+import jax
+
+# Fraction of the free device memory used by default.
+DEFAULT_MEMORY_FRACTION = 0.8
+
+
+def default_memory_budget() -> int | None:
+    """
+    Returns the default memory budget, in bytes, of the chunk size autotuner, which is
+    a fraction of the free memory of the first local device, or None if the
+    device does not report its memory usage (for example on CPU).
+    """
+    try:
+        stats = jax.local_devices()[0].memory_stats()
+    except Exception:  # pragma: no cover
+        stats = None
+    if not stats or "bytes_limit" not in stats:
+        return None
+    free = stats["bytes_limit"] - stats.get("bytes_in_use", 0)
+    return int(DEFAULT_MEMORY_FRACTION * free)
+
+
+def _compile(fun: Callable, *args):
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore")
+        return jax.jit(fun).lower(*args).compile()
+
+
+def compiled_memory(fun: Callable, *args) -> int | None:
+    """
+    Estimates the peak memory, in bytes, required to run `fun(*args)`, by
+    compiling it without executing it.
+
+    The arrays the operation depends on, such as the parameters and the samples,
+    should be passed in `args` rather than being closed over, otherwise they are
+    embedded in the compiled function as constants and not accounted for.
+
+    Returns None if the backend does not provide a memory analysis.
+    """
+    compiled = _compile(fun, *args)
+    stats = compiled.memory_analysis()
+    if stats is None:
+        return None
+    return (
+        stats.temp_size_in_bytes
+        + stats.argument_size_in_bytes
+        + stats.output_size_in_bytes
+        - stats.alias_size_in_bytes
+    )
+
+
+def _largest_power_of_two_below(n: float) -> int:
+    return 1 << max(int(n), 1).bit_length() - 1
+
+
+def select_chunk_size(
+    memory_fun: Callable[[int | None], int | None],
+    n_samples: int,
+    budget: int,
+) -> int | None:
+    """
+    Selects the largest chunk size whose memory fits in `budget`.
+
+    Args:
+        memory_fun: Function returning the estimated memory, in bytes, of the
+            operation with a given chunk size (None for no chunking), or None
+            if the memory cannot be estimated.
+        n_samples: The number of samples per device/rank.
+        budget: The memory budget in bytes.
+
+    Returns:
+        The chunk size, or None if no chunking is needed (or the memory cannot be
+        estimated).
+    """
+    if n_samples <= 1:
+        return None
+
+    memory_full = memory_fun(None)
+    if memory_full is None or memory_full <= budget:
+        return None
+
+    chunk_size = _largest_power_of_two_below(n_samples - 1)
+    previous = (n_samples, memory_full)
+    while True:
+        memory = memory_fun(chunk_size)
+        if memory is None:
+            return None
+        if memory <= budget:
+            return chunk_size
+        if chunk_size == 1:
+            break
+
+        # extrapolate linearly the memory as a function of the chunk size
+        slope = (previous[1] - memory) / (previous[0] - chunk_size)
+        previous = (chunk_size, memory)
+        if slope > 0:
+            estimate = chunk_size - (memory - budget) / slope
+            next_chunk_size = _largest_power_of_two_below(estimate)
+        else:
+            next_chunk_size = chunk_size
+        chunk_size = max(min(next_chunk_size, chunk_size // 2), 1)
+
+    warnings.warn(
+        f"The memory budget of {budget} bytes is too small even with chunk_size=1.",
+        UserWarning,
+        stacklevel=3,
+    )
+    return 1
+
+
+def run_time(fun: Callable, *args, n_repeats: int = 2) -> float:
+    """
+    Measures the run time, in seconds, of `fun(*args)` after compiling it, as
+    the minimum over `n_repeats` executions following a warm-up execution.
+    """
+    compiled = _compile(fun, *args)
+    jax.block_until_ready(compiled(*args))
+    best = float("inf")
+    for _ in range(n_repeats):
+        start = time.perf_counter()
+        jax.block_until_ready(compiled(*args))
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def select_fastest_chunk_size(
+    time_fun: Callable[[int | None], float],
+    largest: int | None,
+    n_samples: int,
+    n_probes: int,
+) -> int | None:
+    """
+    Selects the fastest among `largest` and the `n_probes` next smaller
+    power-of-two chunk sizes.
+
+    Args:
+        time_fun: Function returning the run time of the operation with a given
+            chunk size (None for no chunking).
+        largest: The largest chunk size allowed (None if no chunking is allowed).
+        n_samples: The number of samples per device/rank.
+        n_probes: The number of chunk sizes smaller than `largest` to measure.
+
+    Returns:
+        The fastest chunk size (None for no chunking).
+    """
+    candidates = [largest]
+    chunk_size = n_samples if largest is None else largest
+    for _ in range(n_probes):
+        if chunk_size <= 1:
+            break
+        chunk_size = _largest_power_of_two_below(chunk_size - 1)
+        candidates.append(chunk_size)
+    if len(candidates) == 1:
+        return largest
+    return min(candidates, key=time_fun)
+
+
+def cache_key(operation: str, operator=None) -> tuple:
+    """
+    Key identifying the chunk size of an operation. The memory depends on the
+    type and on the number of connected elements of the operator, but not on
+    its coefficients.
+    """
+    return (operation, type(operator), getattr(operator, "max_conn_size", None))
@@ -18,7 +18,10 @@ from functools import partial
 import jax
 from jax import numpy as jnp
 
+from netket import config
 from netket.stats import Stats, statistics as mpi_statistics
+from netket.stats.mc_stats import _weighted_statistics
+from netket.utils import HashablePartial
 from netket.utils.types import PyTree
 from netket.utils.dispatch import dispatch
 
@@ -28,6 +31,7 @@ from netket.operator import (
     Squared,
     ContinuousOperator,
     DiscreteJaxOperator,
+    SumOperatorJax,
 )
 
 from netket.vqs.mc import (
@@ -65,6 +69,8 @@ def get_local_kernel_arguments(vstate: MCState, Ô: DiscreteOperator):  # noqa:
 
 @dispatch
 def get_local_kernel(vstate: MCState, Ô: DiscreteOperator):  # noqa: F811
+    if hasattr(vstate.model, "generalized_orbitals"):
+        return HashablePartial(kernels.local_value_kernel_slater, vstate.model)
     return kernels.local_value_kernel
 
 
@@ -78,6 +84,27 @@ def get_local_kernel_arguments(vstate: MCState, Ô: DiscreteJaxOperator):  # no
 
 @dispatch
 def get_local_kernel(vstate: MCState, Ô: DiscreteJaxOperator):  # noqa: F811
+    if hasattr(vstate.model, "site_tensors"):
+        # only if the operator acts on few consecutive sites
+        window = kernels.mps_local_value_window(vstate.model, Ô)
+        if window is not None:
+            return HashablePartial(
+                kernels.local_value_kernel_jax_mps, vstate.model, window=window
+            )
+    if hasattr(vstate.model, "generalized_orbitals"):
+        return HashablePartial(kernels.local_value_kernel_jax_slater, vstate.model)
+    # deduplication gathers all configurations, so it is not used when sharding
+    if (
+        vstate.deduplicate_local_values is not None
+        and not config.netket_experimental_sharding
+    ):
+        return HashablePartial(
+            kernels.local_value_kernel_jax_unique,
+            unique_fraction=vstate.deduplicate_local_values,
+        )
+    if isinstance(Ô, SumOperatorJax) and not config.netket_experimental_sharding:
+        # skip the connected states merged with others
+        return kernels.local_value_kernel_jax_nonzero
     return kernels.local_value_kernel_jax
 
 
@@ -105,6 +132,9 @@ def get_local_kernel(vstate: MCState, Ô: ContinuousOperator):  # noqa: F811
 def expect(
     vstate: MCState, Ô: AbstractOperator, chunk_size: None
 ) -> Stats:  # noqa: F811
+    if vstate._has_sample_weights:
+        return expect_unique(vstate, Ô)
+
     σ, args = get_local_kernel_arguments(vstate, Ô)
     local_estimator_fun = get_local_kernel(vstate, Ô)
 
@@ -154,3 +184,43 @@ def _expect(
     Ō_stats = mpi_statistics(L_σ.reshape((n_chains, -1)))
 
     return Ō_stats
+
+
+def expect_unique(vstate: MCState, Ô: AbstractOperator) -> Stats:
+    """
+    Computes the expectation value of `Ô` evaluating the local estimators only
+    on the distinct samples of the last sampling, weighted by their number of
+    occurrences, or on the samples weighted by the sampler.
+    """
+    with vstate._unique_samples_scope():
+        σ, args = get_local_kernel_arguments(vstate, Ô)
+    local_estimator_fun = get_local_kernel(vstate, Ô)
+
+    return _expect_weighted(
+        local_estimator_fun,
+        vstate._apply_fun,
+        vstate.parameters,
+        vstate.model_state,
+        σ,
+        args,
+        vstate._sample_weights,
+        vstate._n_effective_samples,
+    )
+
+
+@partial(jax.jit, static_argnums=(0, 1))
+def _expect_weighted(
+    local_value_kernel: Callable,
+    model_apply_fun: Callable,
+    parameters: PyTree,
+    model_state: PyTree,
+    σ: jnp.ndarray,
+    local_value_args: PyTree,
+    weights: jnp.ndarray,
+    n_samples: int,
+) -> Stats:
+    def logpsi(w, σ):
+        return model_apply_fun({"params": w, **model_state}, σ)
+
+    L_σ = local_value_kernel(logpsi, parameters, σ, local_value_args)
+    return _weighted_statistics(L_σ, weights, n_samples)
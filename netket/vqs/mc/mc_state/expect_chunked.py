@@ -20,6 +20,7 @@ import jax
 from jax import numpy as jnp
 
 from netket import jax as nkjax
+from netket import config
 from netket.stats import Stats
 from netket.utils.types import PyTree
 from netket.utils.dispatch import dispatch
@@ -28,6 +29,7 @@ from netket.operator import (
     AbstractOperator,
     DiscreteOperator,
     DiscreteJaxOperator,
+    SumOperatorJax,
     ContinuousOperator,
     Squared,
 )
@@ -56,6 +58,29 @@ def get_local_kernel(vstate: MCState, Ô: Squared, chunk_size: int):  # noqa: F
 def get_local_kernel(  # noqa: F811
     vstate: MCState, Ô: DiscreteJaxOperator, chunk_size: int
 ):  # noqa: F811
+    if hasattr(vstate.model, "site_tensors"):
+        # only if the operator acts on few consecutive sites
+        window = kernels.mps_local_value_window(vstate.model, Ô)
+        if window is not None:
+            return nkjax.HashablePartial(
+                kernels.local_value_kernel_jax_mps_chunked, vstate.model, window=window
+            )
+    if hasattr(vstate.model, "generalized_orbitals"):
+        return nkjax.HashablePartial(
+            kernels.local_value_kernel_jax_slater_chunked, vstate.model
+        )
+    # deduplication gathers all configurations, so it is not used when sharding
+    if (
+        vstate.deduplicate_local_values is not None
+        and not config.netket_experimental_sharding
+    ):
+        return nkjax.HashablePartial(
+            kernels.local_value_kernel_jax_unique_chunked,
+            unique_fraction=vstate.deduplicate_local_values,
+        )
+    if isinstance(Ô, SumOperatorJax) and not config.netket_experimental_sharding:
+        # skip the connected states merged with others
+        return kernels.local_value_kernel_jax_nonzero_chunked
     return kernels.local_value_kernel_jax_chunked
 
 
@@ -63,6 +88,10 @@ def get_local_kernel(  # noqa: F811
 def get_local_kernel(  # noqa: F811
     vstate: MCState, Ô: DiscreteOperator, chunk_size: int
 ):
+    if hasattr(vstate.model, "generalized_orbitals"):
+        return nkjax.HashablePartial(
+            kernels.local_value_kernel_slater_chunked, vstate.model
+        )
     return kernels.local_value_kernel_chunked
 
 
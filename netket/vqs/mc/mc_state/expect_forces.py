@@ -21,6 +21,7 @@ from flax.core.scope import CollectionFilter, DenyList  # noqa: F401
 
 from netket import jax as nkjax
 from netket.stats import Stats, statistics
+from netket.stats.mc_stats import _weighted_statistics
 from netket.utils import mpi
 from netket.utils.types import PyTree
 from netket.utils.dispatch import dispatch
@@ -45,6 +46,9 @@ def expect_and_forces(  # noqa: F811
     *,
     mutable: CollectionFilter = False,
 ) -> tuple[Stats, PyTree]:
+    if mutable is False and vstate._has_sample_weights:
+        return expect_and_forces_unique(vstate, Ô)
+
     σ, args = get_local_kernel_arguments(vstate, Ô)
 
     local_estimator_fun = get_local_kernel(vstate, Ô)
@@ -113,3 +117,62 @@ def forces_expect_hermitian(
         Ō_grad,
         new_model_state,
     )
+
+
+def expect_and_forces_unique(vstate: MCState, Ô: AbstractOperator):
+    """
+    Computes the expectation value of `Ô` and the forces evaluating the local
+    estimators and the model only on the distinct samples of the last sampling,
+    weighted by their number of occurrences, or on the samples weighted by the
+    sampler.
+    """
+    with vstate._unique_samples_scope():
+        σ, args = get_local_kernel_arguments(vstate, Ô)
+    local_estimator_fun = get_local_kernel(vstate, Ô)
+
+    return forces_expect_hermitian_weighted(
+        local_estimator_fun,
+        vstate._apply_fun,
+        vstate.parameters,
+        vstate.model_state,
+        σ,
+        args,
+        vstate._sample_weights,
+        vstate._n_effective_samples,
+    )
+
+
+@partial(jax.jit, static_argnums=(0, 1))
+def forces_expect_hermitian_weighted(
+    local_value_kernel: Callable,
+    model_apply_fun: Callable,
+    parameters: PyTree,
+    model_state: PyTree,
+    σ: jnp.ndarray,
+    local_value_args: PyTree,
+    weights: jnp.ndarray,
+    n_samples: int,
+) -> tuple[PyTree, PyTree]:
+    O_loc = local_value_kernel(
+        model_apply_fun,
+        {"params": parameters, **model_state},
+        σ,
+        local_value_args,
+    )
+
+    Ō = _weighted_statistics(O_loc, weights, n_samples)
+
+    # the padding entries, with zero weight, are masked as they might not be finite
+    O_loc = jnp.where(weights > 0, O_loc - Ō.mean, 0)
+
+    _, vjp_fun = nkjax.vjp(
+        lambda w: model_apply_fun({"params": w, **model_state}, σ),
+        parameters,
+        conjugate=True,
+    )
+    # the weights include the normalization by the number of samples
+    Ō_grad = vjp_fun(weights * jnp.conjugate(O_loc))[0]
+
+    Ō_grad, _ = mpi.mpi_sum_jax(Ō_grad)
+
+    return Ō, Ō_grad
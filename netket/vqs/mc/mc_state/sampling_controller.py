@@ -0,0 +1,218 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Automatic selection of the sweep size and of the number of discarded samples.
+#
+# Every `check_interval` samplings, the integrated autocorrelation time τ and
+# the split-R̂ of the last samples along the chains are read. They are those of
+# the first expectation value estimated on the samples, or, if there was none,
+# those of the log-probability of the samples. The
+# autocorrelation time in units of elementary Metropolis steps, τ × sweep_size,
+# does not depend on the sweep size, so the sweep size giving the target
+# autocorrelation time is predicted from a running average of it. The
+# number of discarded samples is proportional to the autocorrelation time, and
+# doubled every time that R̂ signals that the chains were not equilibrated.
+
+import math
+from functools import partial
+
+import jax
+
+from netket.stats.mc_stats import _statistics
+
+
+@partial(jax.jit, static_argnums=(0,))
+def chain_diagnostics(model, machine_pow, variables, samples):
+    """
+    Returns the statistics of the log-probability of `samples`, of shape
+    `(n_chains, chain_length, N)`, along the Markov chains.
+    """
+    σ = samples.reshape(-1, samples.shape[-1])
+    log_prob = machine_pow * model.apply(variables, σ).real
+    return _statistics(log_prob.reshape(samples.shape[:-1]))
+
+
+def _nearest_power_of_two(x: float) -> int:
+    return 1 << max(round(math.log2(max(x, 1))), 0)
+
+
+def _next_power_of_two(x: float) -> int:
+    return 1 << max(math.ceil(math.log2(max(x, 1))), 0)
+
+
+class SamplingController:
+    r"""
+    Adapts the sweep size of a Metropolis sampler and the number of discarded
+    samples of a :class:`~netket.vqs.MCState` every `check_interval` samplings,
+    to obtain a target effective sample size at the minimum cost.
+
+    The effective sample size is :math:`N_\text{samples}/\tau`, where
+    :math:`\tau` is the integrated autocorrelation time (in units of samples).
+    The controller reuses the autocorrelation time and the split-:math:`\hat R`
+    of the first expectation value (for example, the energy computed by
+    :meth:`~netket.vqs.MCState.expect_and_grad`) estimated on the samples, so
+    that it does not require any additional evaluation of the model. If no
+    expectation value was computed, the model is evaluated on the samples to
+    measure the statistics of their log-probability. In both cases, the
+    statistics are transferred to the host only at the check interval.
+
+    The cost of Monte Carlo estimators is
+    proportional to the number of samples, and the cost of sampling to the
+    product of the number of samples and of the sweep size, so the sweep size
+    is chosen such that :math:`\tau` equals `1/target_ess_fraction`.
+
+    The number of discarded samples is `discard_factor` times the autocorrelation
+    time, and it is doubled whenever the split-:math:`\hat R` of the chains exceeds
+    `r_hat_threshold`.
+
+    To bound the number of compilations, both the sweep size and the number of
+    discarded samples are rounded to powers of two.
+
+    Example:
+
+        >>> import netket as nk
+        >>> hi = nk.hilbert.Spin(0.5, 8)
+        >>> sa = nk.sampler.MetropolisLocal(hi)
+        >>> vs = nk.vqs.MCState(
+        ...     sa, nk.models.RBM(), sampling_controller=nk.vqs.SamplingController()
+        ... )
+        >>> _ = vs.sample()
+        >>> vs.sampler.sweep_size  # doctest: +SKIP
+        4
+    """
+
+    def __init__(
+        self,
+        target_ess_fraction: float = 0.5,
+        *,
+        r_hat_threshold: float = 1.05,
+        discard_factor: float = 4.0,
+        min_sweep_size: int = 1,
+        max_sweep_size: int | None = None,
+        smoothing: float = 0.5,
+        check_interval: int = 5,
+    ):
+        r"""
+        Constructs the controller.
+
+        Args:
+            target_ess_fraction: The target ratio, in (0, 1], between the effective
+                sample size and the number of samples (default: 0.5).
+            r_hat_threshold: The value of the split-:math:`\hat R` above which the
+                chains are considered not equilibrated (default: 1.05).
+            discard_factor: The number of discarded samples in units of the
+                autocorrelation time (default: 4).
+            min_sweep_size: The minimum sweep size (default: 1).
+            max_sweep_size: The maximum sweep size (default: no maximum).
+            smoothing: The weight, in (0, 1], of the last measurement in the running
+                average of the autocorrelation time (default: 0.5).
+            check_interval: Every how many samplings the diagnostics are read and
+                the sweep size is updated (default: 5).
+        """
+        if not 0 < target_ess_fraction <= 1:
+            raise ValueError("target_ess_fraction must be in (0, 1].")
+        if not 0 < smoothing <= 1:
+            raise ValueError("smoothing must be in (0, 1].")
+        if min_sweep_size < 1 or (
+            max_sweep_size is not None and max_sweep_size < min_sweep_size
+        ):
+            raise ValueError("Invalid range of sweep sizes.")
+        if check_interval < 1:
+            raise ValueError("check_interval must be at least 1.")
+
+        self.target_ess_fraction = target_ess_fraction
+        self.r_hat_threshold = r_hat_threshold
+        self.discard_factor = discard_factor
+        self.min_sweep_size = min_sweep_size
+        self.max_sweep_size = max_sweep_size
+        self.smoothing = smoothing
+        self.check_interval = check_interval
+
+        # diagnostics measured at the last sampling
+        self.tau_corr = math.nan
+        self.R_hat = math.nan
+        # running average of the log of the autocorrelation time in elementary steps
+        self._log_tau_steps = None
+        # number of samplings since the last update
+        self._n_samplings = 0
+
+    @property
+    def target_tau_corr(self) -> float:
+        """The target autocorrelation time, in units of samples."""
+        return 1 / self.target_ess_fraction
+
+    def is_due(self) -> bool:
+        """
+        Counts a new sampling, and returns whether the diagnostics should be
+        read to update the controller.
+        """
+        self._n_samplings += 1
+        return self._n_samplings >= self.check_interval
+
+    def update(
+        self,
+        sweep_size: int,
+        n_discard_per_chain: int,
+        chain_length: int,
+        tau_corr: float,
+        R_hat: float,
+    ) -> tuple[int, int]:
+        """
+        Updates the controller with the diagnostics of the last sampling.
+
+        Args:
+            sweep_size: The sweep size used for the last sampling.
+            n_discard_per_chain: The number of samples discarded in the last sampling.
+            chain_length: The length of the chains.
+            tau_corr: The measured autocorrelation time.
+            R_hat: The measured split-R̂.
+
+        Returns:
+            The sweep size and number of discarded samples for the next sampling.
+        """
+        self._n_samplings = 0
+        self.tau_corr = tau_corr
+        self.R_hat = R_hat
+        if not math.isfinite(tau_corr):
+            return sweep_size, n_discard_per_chain
+
+        # autocorrelation time in units of elementary steps
+        log_tau_steps = math.log(max(tau_corr, 0.5) * sweep_size)
+        if self._log_tau_steps is None:
+            self._log_tau_steps = log_tau_steps
+        else:
+            self._log_tau_steps += self.smoothing * (
+                log_tau_steps - self._log_tau_steps
+            )
+        tau_steps = math.exp(self._log_tau_steps)
+
+        new_sweep_size = _nearest_power_of_two(tau_steps / self.target_tau_corr)
+        new_sweep_size = max(new_sweep_size, self.min_sweep_size)
+        if self.max_sweep_size is not None:
+            new_sweep_size = min(new_sweep_size, self.max_sweep_size)
+
+        new_n_discard = _next_power_of_two(
+            self.discard_factor * tau_steps / new_sweep_size
+        )
+        if math.isfinite(R_hat) and R_hat > self.r_hat_threshold:
+            new_n_discard = max(new_n_discard, 2 * n_discard_per_chain)
+        new_n_discard = min(new_n_discard, chain_length)
+
+        return new_sweep_size, new_n_discard
+
+    def __repr__(self):
+        return (
+            f"SamplingController(target_ess_fraction={self.target_ess_fraction}, "
+            f"tau_corr={self.tau_corr:.2f}, R_hat={self.R_hat:.4f})"
+        )
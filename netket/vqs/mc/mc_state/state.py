@@ -12,7 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import copy
 import warnings
+from contextlib import contextmanager
 from functools import partial
 from collections.abc import Callable
 
@@ -53,6 +55,9 @@ from netket.vqs.base import (
 )
 from netket.vqs.mc import get_local_kernel, get_local_kernel_arguments
 
+from . import chunk_autotune
+from .sampling_controller import SamplingController, chain_diagnostics
+
 
 def compute_chain_length(n_chains, n_samples):
     if n_samples <= 0:
@@ -76,19 +81,6 @@ def compute_chain_length(n_chains, n_samples):
     return chain_length
 
 
-def check_chunk_size(n_samples, chunk_size):
-    n_samples_per_rank = n_samples // sharding.device_count()
-
-    if chunk_size is not None:
-        if chunk_size < n_samples_per_rank and n_samples_per_rank % chunk_size != 0:
-            raise ValueError(
-                f"chunk_size={chunk_size}`<`n_samples_per_rank={n_samples_per_rank}, "
-                "chunk_size is not an integer fraction of `n_samples_per rank`. This is"
-                "unsupported. Please change `chunk_size` so that it divides evenly the"
-                "number of samples per rank or set it to `None` to disable chunking."
-            )
-
-
 def _is_power_of_two(n: int) -> bool:
     return (n != 0) and (n & (n - 1) == 0)
 
@@ -153,6 +145,21 @@ class MCState(VariationalState):
     """Number of samples discarded at the beginning of every Markov chain."""
     _chunk_size: int | None = None
     """The chunk size used in the evaluation of the model."""
+    _chunk_size_auto: bool = False
+    """Whether the chunk size is selected automatically for every operation."""
+    _chunk_memory_budget: int | None = None
+    """The memory budget, in bytes, used to select the chunk size automatically."""
+    _chunk_timing_probes: int = 0
+    """The number of smaller chunk sizes whose run time is measured."""
+    _auto_chunk_sizes: dict
+    """The chunk sizes selected automatically for every operation."""
+    _deduplicate_local_values: float | None = None
+    """The fraction of configurations evaluated when deduplicating local values."""
+    _sampling_controller: SamplingController | None = None
+    """The controller adapting the sweep size and the number of discarded samples."""
+    _sampling_stats: Stats | None = None
+    """The statistics of the first expectation value estimated on the current samples,
+    used by the sampling controller."""
 
     #####################
     #   Model related   #
@@ -179,6 +186,14 @@ class MCState(VariationalState):
     #############
     _samples: jax.Array | None = None
     """Cached samples obtained with the last sampling."""
+    _unique_samples: jax.Array | None = None
+    """Distinct samples of the last sampling, if the sampler provides them."""
+    _sample_weights: jax.Array | None = None
+    """Weights of the distinct samples, summing to 1 across all ranks."""
+    _n_effective_samples: int | None = None
+    """Number of samples determining the error of weighted expectation values."""
+    _use_unique_samples: bool = False
+    """Whether :attr:`samples` returns the distinct samples."""
 
     def __init__(
         self,
@@ -188,7 +203,10 @@ class MCState(VariationalState):
         n_samples: int | None = None,
         n_samples_per_rank: int | None = None,
         n_discard_per_chain: int | None = None,
-        chunk_size: int | None = None,
+        chunk_size: int | str | None = None,
+        chunk_memory_budget: int | None = None,
+        chunk_timing_probes: int = 0,
+        sampling_controller: SamplingController | None = None,
         variables: PyTree | None = None,
         init_fun: NNInitFunc | None = None,
         apply_fun: Callable | None = None,
@@ -225,9 +243,20 @@ class MCState(VariationalState):
                 Useful for example when you have a batchnorm layer that constructs the average/mean only during training.
             chunk_size: (Defaults to `None`) If specified, calculations are split into chunks where the neural network
                 is evaluated at most on :code:`chunk_size` samples at once. This does not change the mathematical results,
-                but will trade a higher computational cost for lower memory cost.
+                but will trade a higher computational cost for lower memory cost. If `"auto"`, the largest chunk size
+                fitting in `chunk_memory_budget` is selected for every operation the first time it is executed.
+            chunk_memory_budget: (Defaults to `None`) The memory budget in bytes used when `chunk_size="auto"`. If not
+                specified, 80% of the free memory of the device is used, and no chunking is done if the device does not
+                report its memory usage (for example on CPU).
+            chunk_timing_probes: (Defaults to 0) If positive and `chunk_size="auto"`, the run time of the largest
+                chunk size fitting in the memory budget and of this many smaller power-of-two chunk sizes is measured,
+                and the fastest is used. If the memory is not limited, the candidates start from no chunking.
+            sampling_controller: (Defaults to `None`) A :class:`~netket.vqs.SamplingController` adapting the sweep
+                size of the sampler and `n_discard_per_chain` at its check interval, based on the measured
+                autocorrelation time and split-R̂ of the chains.
         """
         super().__init__(sampler.hilbert)
+        self._auto_chunk_sizes = {}
 
         # TODO: Move this somewhere else below?
         # If variables is specified manually, we will enforce that it's leafs are
@@ -321,7 +350,10 @@ class MCState(VariationalState):
 
         self.n_discard_per_chain = n_discard_per_chain  # type: ignore[assignment]
 
+        self.chunk_memory_budget = chunk_memory_budget
+        self.chunk_timing_probes = chunk_timing_probes
         self.chunk_size = chunk_size
+        self.sampling_controller = sampling_controller
 
     def init(self, seed=None, dtype=None):
         """
@@ -407,8 +439,6 @@ class MCState(VariationalState):
         # to the new `sampler.n_chains`.
         # If `n_samples` is divisible by the new `sampler.n_chains`, it will be
         # unchanged; otherwise it will be rounded up.
-        # If the new `n_samples_per_rank` is not divisible by `chunk_size`, a
-        # `ValueError` will be raised.
         # `_chain_length == 0` means that this `MCState` is being constructed.
         if self._chain_length > 0:
             self.n_samples = n_samples_old  # type: ignore
@@ -449,10 +479,9 @@ class MCState(VariationalState):
         if chain_length <= 0:
             raise ValueError(f"Invalid chain length: chain_length={chain_length}")
 
-        n_samples = chain_length * self.sampler.n_chains
-        check_chunk_size(n_samples, self.chunk_size)
-
         self._chain_length = chain_length
+        # the memory of all operations changes with the number of samples
+        self._auto_chunk_sizes = {}
         self.reset()
 
     @property
@@ -489,6 +518,7 @@ class MCState(VariationalState):
         of the Neural Network model.
 
         If your inputs are smaller than the chunk size this setting is ignored.
+        If it does not divide the number of samples per rank, the last chunk is padded.
 
         This can be used to lower the memory required to run a computation with a very
         high number of samples or on a very large lattice. Notice that inputs and
@@ -503,11 +533,26 @@ class MCState(VariationalState):
         an operation that is not implemented with chunking support, it will fall back
         to no chunking. To check if this happened, set the environment variable
         `NETKET_DEBUG=1`.
+
+        It can be set to `"auto"` to select the chunk size automatically (see
+        :attr:`chunk_size_auto`). In that case, this returns the smallest chunk size
+        selected so far, which is used by the operations that are not autotuned.
         """
+        if self._chunk_size_auto:
+            chunk_sizes = [c for c in self._auto_chunk_sizes.values() if c is not None]
+            return min(chunk_sizes, default=None)
         return self._chunk_size
 
     @chunk_size.setter
-    def chunk_size(self, chunk_size: int | None):
+    def chunk_size(self, chunk_size: int | str | None):
+        if chunk_size == "auto":
+            self._chunk_size_auto = True
+            self._chunk_size = None
+            self._auto_chunk_sizes = {}
+            return
+
+        self._chunk_size_auto = False
+
         # disable chunks if it is None
         if chunk_size is None:
             self._chunk_size = None
@@ -515,7 +560,7 @@ class MCState(VariationalState):
 
         if not isinstance(chunk_size, int) or chunk_size <= 0:
             raise ValueError(
-                f"Chunk size must be a positive INTEGER (got {chunk_size} instead)."
+                f"Chunk size must be a positive INTEGER or 'auto' (got {chunk_size} instead)."
             )
 
         if not _is_power_of_two(chunk_size):
@@ -524,16 +569,220 @@ class MCState(VariationalState):
                 stacklevel=2,
             )
 
-        check_chunk_size(self.n_samples, chunk_size)
-
         self._chunk_size = chunk_size
 
+    @property
+    def chunk_size_auto(self) -> bool:
+        """
+        Whether the chunk size is selected automatically (`chunk_size="auto"`).
+
+        When True, the memory required by :meth:`expect`, :meth:`expect_and_grad`,
+        :meth:`expect_and_forces` and by :class:`~netket.optimizer.qgt.QGTOnTheFly`
+        is estimated at compile time the first time they are called with a given
+        type of operator, and the largest power-of-two chunk size fitting in
+        :attr:`chunk_memory_budget` is used, unless :attr:`chunk_timing_probes`
+        smaller chunk sizes are found to be faster.
+        """
+        return self._chunk_size_auto
+
+    @property
+    def chunk_memory_budget(self) -> int | None:
+        """
+        The memory budget, in bytes, used to select the chunk size when
+        :attr:`chunk_size_auto` is True. If None, a fraction of the free memory
+        of the device is used.
+        """
+        return self._chunk_memory_budget
+
+    @chunk_memory_budget.setter
+    def chunk_memory_budget(self, budget: int | None):
+        if budget is not None and budget <= 0:
+            raise ValueError(f"The memory budget must be positive (got {budget}).")
+        self._chunk_memory_budget = budget
+        self._auto_chunk_sizes = {}
+
+    @property
+    def chunk_timing_probes(self) -> int:
+        """
+        The number of chunk sizes, smaller than the largest one fitting in
+        :attr:`chunk_memory_budget`, whose run time is measured on the current
+        samples when :attr:`chunk_size_auto` is True. The fastest of them and of
+        the largest one is used. If 0 (the default), the largest one is used
+        without measuring any run time.
+
+        If the memory is not limited (for example on CPU, without a memory
+        budget), the candidates start from no chunking.
+        """
+        return self._chunk_timing_probes
+
+    @chunk_timing_probes.setter
+    def chunk_timing_probes(self, n_probes: int):
+        if not isinstance(n_probes, int) or n_probes < 0:
+            raise ValueError(
+                f"The number of timing probes must be a non-negative integer "
+                f"(got {n_probes})."
+            )
+        self._chunk_timing_probes = n_probes
+        self._auto_chunk_sizes = {}
+
+    @property
+    def deduplicate_local_values(self) -> float | None:
+        """
+        If not None, the local values of jax operators evaluate the model only
+        once for every distinct configuration among the samples and their
+        connected configurations (Defaults None).
+
+        The distinct configurations are evaluated in a buffer holding this
+        fraction, in :math:`(0, 1]`, of all the configurations, so that the model
+        is evaluated on :math:`1/f` times fewer configurations. If there are more
+        distinct configurations than fit in the buffer, all of them are evaluated
+        after the additional cost of sorting them, so this should be set a bit
+        above the fraction of distinct configurations expected, which is small
+        for low-entropy states near convergence.
+
+        This is not used with sharding, and is applied within every chunk if
+        :attr:`chunk_size` is set.
+        """
+        return self._deduplicate_local_values
+
+    @deduplicate_local_values.setter
+    def deduplicate_local_values(self, fraction: float | None):
+        if fraction is not None and (
+            isinstance(fraction, bool) or not 0 < fraction <= 1
+        ):
+            raise ValueError(
+                "The fraction of deduplicated configurations must be in (0, 1] "
+                f"or None (got {fraction})."
+            )
+        self._deduplicate_local_values = fraction
+
+    def _autotuned_chunk_size(
+        self, key: tuple, fun: Callable[["MCState", int | None], object]
+    ) -> int | None:
+        """
+        Returns the chunk size to be used for the operation identified by `key`.
+
+        If the chunk size is selected automatically, the first time this is called
+        for a given key the memory required by `fun(vstate, chunk_size)` is
+        estimated by compiling it for several chunk sizes, and its run time is
+        measured if :attr:`chunk_timing_probes` is positive. `vstate` is a copy of
+        this state whose parameters and samples are the arguments of the compiled
+        function, so that their size is accounted for.
+        """
+        if not self._chunk_size_auto:
+            return self.chunk_size
+
+        if key not in self._auto_chunk_sizes:
+            # sample outside of the traced function
+            self.samples
+            arrays = (
+                self._parameters,
+                self._model_state,
+                self._samples,
+                self._unique_samples,
+                self._sample_weights,
+            )
+
+            def fun_of_arrays(chunk_size, *arrays):
+                vstate = copy.copy(self)
+                (
+                    vstate._parameters,
+                    vstate._model_state,
+                    vstate._samples,
+                    vstate._unique_samples,
+                    vstate._sample_weights,
+                ) = arrays
+                return fun(vstate, chunk_size)
+
+            budget = self.chunk_memory_budget
+            if budget is None:
+                budget = chunk_autotune.default_memory_budget()
+            if budget is None:
+                chunk_size = None
+            else:
+                chunk_size = chunk_autotune.select_chunk_size(
+                    lambda c: chunk_autotune.compiled_memory(
+                        partial(fun_of_arrays, c), *arrays
+                    ),
+                    self.n_samples_per_rank,
+                    budget,
+                )
+            if self.chunk_timing_probes > 0:
+                chunk_size = chunk_autotune.select_fastest_chunk_size(
+                    lambda c: chunk_autotune.run_time(
+                        partial(fun_of_arrays, c), *arrays
+                    ),
+                    chunk_size,
+                    self.n_samples_per_rank,
+                    self.chunk_timing_probes,
+                )
+            self._auto_chunk_sizes[key] = chunk_size
+        return self._auto_chunk_sizes[key]
+
+    @property
+    def sampling_controller(self) -> SamplingController | None:
+        """
+        The :class:`~netket.vqs.SamplingController` adapting the sweep size of the
+        sampler and :attr:`n_discard_per_chain` at its check interval, or None.
+        """
+        return self._sampling_controller
+
+    @sampling_controller.setter
+    def sampling_controller(self, controller: SamplingController | None):
+        if controller is not None:
+            if self.sampler.is_exact or not hasattr(self.sampler, "sweep_size"):
+                raise TypeError(
+                    "A sampling controller can only be used with Metropolis samplers, "
+                    f"not with {type(self.sampler).__name__}."
+                )
+        self._sampling_controller = controller
+
+    def _record_sampling_stats(self, stats):
+        # Keeps the statistics of the first expectation value estimated on the
+        # current samples, which the sampling controller reads instead of
+        # evaluating the model on the samples again.
+        if self._sampling_controller is not None and self._sampling_stats is None:
+            if isinstance(stats, Stats):
+                self._sampling_stats = stats
+
+    def _update_sampling_controller(self):
+        # At the check interval of the controller, reads the diagnostics of the
+        # last samples and updates the sweep size and the number of discarded
+        # samples for the next sampling.
+        if not self._sampling_controller.is_due():
+            return
+
+        stats = self._sampling_stats
+        if stats is None:
+            if self._samples is None:
+                return
+            stats = chain_diagnostics(
+                self._sampler_model,
+                self.sampler.machine_pow,
+                self._sampler_variables,
+                self._unpack_samples(self._samples),
+            )
+        sweep_size, n_discard = self._sampling_controller.update(
+            self.sampler.sweep_size,
+            self.n_discard_per_chain,
+            self.chain_length,
+            float(stats.tau_corr),
+            float(stats.R_hat),
+        )
+        if sweep_size != self.sampler.sweep_size:
+            # the sampler state does not depend on the sweep size, so it is kept
+            self._sampler = self.sampler.replace(sweep_size=sweep_size)
+        self._n_discard_per_chain = n_discard
+
     def reset(self):
         """
         Resets the sampled states. This method is called automatically every time
         that the parameters/state is updated.
         """
         self._samples = None
+        self._unique_samples = None
+        self._sample_weights = None
+        self._n_effective_samples = None
 
     @timing.timed
     def sample(
@@ -563,8 +812,9 @@ class MCState(VariationalState):
             elif chain_length is None:
                 chain_length = compute_chain_length(self.sampler.n_chains, n_samples)
 
-            if self.chunk_size is not None:
-                check_chunk_size(chain_length * self.sampler.n_chains, self.chunk_size)
+        if self._sampling_controller is not None:
+            self._update_sampling_controller()
+            self._sampling_stats = None
 
         if n_discard_per_chain is None:
             n_discard_per_chain = self.n_discard_per_chain
@@ -593,7 +843,74 @@ class MCState(VariationalState):
             state=self.sampler_state,
             chain_length=chain_length,
         )
-        return self._samples
+
+        self._update_unique_samples()
+
+        return self._unpack_samples(self._samples)
+
+    def _unpack_samples(self, σ):
+        # The samples of a sampler with `packed_states=True` are cached in the
+        # bit-packed representation, and unpacked only when they are used.
+        if getattr(self.sampler, "packed_states", False):
+            return self.sampler._unpack_states(σ)
+        return σ
+
+    def _update_unique_samples(self):
+        # Stores the distinct samples and their weights if the sampler provides
+        # them (see `ARDirectSampler(unique_samples=True)`), or the weights of the
+        # chains (see `PopulationAnnealingSampler(resample_final=False)`).
+        counts = getattr(self.sampler_state, "counts", None)
+        log_weights = getattr(self.sampler_state, "log_weights", None)
+        if counts is not None:
+            # round up to a power of two to bound the number of compilations
+            n_unique = int(self.sampler_state.n_unique)
+            size = min(1 << (n_unique - 1).bit_length(), counts.shape[0])
+            self._unique_samples = self.sampler_state.unique_σ[:size]
+            self._sample_weights = counts[:size] / self.n_samples
+            self._n_effective_samples = self.n_samples
+        elif log_weights is not None and not self.sampler.resample_final:
+            samples = self._unpack_samples(self._samples)
+            # the length of the last chains, which `sample(chain_length=...)` can
+            # set to a value different from `self.chain_length`
+            chain_length = samples.shape[1]
+            # the log-weights are normalized such that their mean is 1 on every rank
+            weights = jnp.exp(log_weights)[:, None] / (
+                self.sampler.n_chains * chain_length
+            )
+            weights = jnp.broadcast_to(weights, samples.shape[:-1])
+            self._unique_samples = samples.reshape(-1, samples.shape[-1])
+            self._sample_weights = weights.reshape(-1)
+            self._n_effective_samples = float(
+                self.sampler_state.effective_sample_size * chain_length
+            )
+        else:
+            self._unique_samples = None
+            self._sample_weights = None
+            self._n_effective_samples = None
+
+    @property
+    def _has_sample_weights(self) -> bool:
+        """
+        Whether the last sampling provided distinct samples with weights, which
+        are used instead of :attr:`samples` to compute expectation values.
+        """
+        if self._samples is None:
+            self.sample()
+        return self._sample_weights is not None
+
+    @contextmanager
+    def _unique_samples_scope(self):
+        """
+        Within this context, :attr:`samples` returns the distinct samples, whose
+        weights are stored in `_sample_weights`.
+        """
+        if self._samples is None:
+            self.sample()
+        self._use_unique_samples = True
+        try:
+            yield
+        finally:
+            self._use_unique_samples = False
 
     @property
     def samples(self) -> jax.Array:
@@ -606,10 +923,17 @@ class MCState(VariationalState):
 
         To obtain a new set of samples either use
         :meth:`~MCState.reset` or :meth:`~MCState.sample`.
+
+        If the sampler stores the samples bit-packed (see the `packed_states`
+        argument of :class:`~netket.sampler.MetropolisSampler`), they are cached
+        packed and unpacked every time this property is accessed. Expectation
+        values and gradients are therefore computed on the unpacked states.
         """
         if self._samples is None:
             self.sample()
-        return self._samples  # type: ignore[return-value]
+        if self._use_unique_samples:
+            return self._unique_samples
+        return self._unpack_samples(self._samples)  # type: ignore[return-value]
 
     def log_value(self, σ: jnp.ndarray) -> jnp.ndarray:
         r"""
@@ -672,7 +996,12 @@ class MCState(VariationalState):
             An estimation of the quantum expectation value
             :math:`\langle O\rangle`.
         """
-        return expect(self, O, self.chunk_size)
+        chunk_size = self._autotuned_chunk_size(
+            chunk_autotune.cache_key("expect", O), lambda vs, c: expect(vs, O, c)
+        )
+        Ō = expect(self, O, chunk_size)
+        self._record_sampling_stats(Ō)
+        return Ō
 
     # override to use chunks
     @timing.timed
@@ -707,13 +1036,20 @@ class MCState(VariationalState):
         if mutable is None:
             mutable = self.mutable
 
-        return expect_and_grad(
+        # the model state is not updated while estimating the memory
+        chunk_size = self._autotuned_chunk_size(
+            chunk_autotune.cache_key("expect_and_grad", O),
+            lambda vs, c: expect_and_grad(vs, O, c, mutable=False, **kwargs),
+        )
+        Ō, Ō_grad = expect_and_grad(
             self,
             O,
-            self.chunk_size,
+            chunk_size,
             mutable=mutable,
             **kwargs,
         )
+        self._record_sampling_stats(Ō)
+        return Ō, Ō_grad
 
     # override to use chunks
     @timing.timed
@@ -756,7 +1092,13 @@ class MCState(VariationalState):
         if mutable is None:
             mutable = self.mutable
 
-        return expect_and_forces(self, O, self.chunk_size, mutable=mutable)
+        chunk_size = self._autotuned_chunk_size(
+            chunk_autotune.cache_key("expect_and_forces", O),
+            lambda vs, c: expect_and_forces(vs, O, c, mutable=False),
+        )
+        Ō, Ō_forces = expect_and_forces(self, O, chunk_size, mutable=mutable)
+        self._record_sampling_stats(Ō)
+        return Ō, Ō_forces
 
     def quantum_geometric_tensor(
         self, qgt_T: QGTConstructor | None = None
@@ -858,7 +1200,7 @@ def serialize_MCState(vstate):
         "sampler_state": serialization.to_state_dict(sampler_state),
         "n_samples": vstate.n_samples,
         "n_discard_per_chain": vstate.n_discard_per_chain,
-        "chunk_size": vstate.chunk_size,
+        "chunk_size": "auto" if vstate.chunk_size_auto else vstate.chunk_size,
     }
     return state_dict
 
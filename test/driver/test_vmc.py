@@ -132,6 +132,55 @@ def test_vmc_progress_bar():
     assert not len(pbar)
 
 
+def test_vmc_async_logging():
+    ha, sx, ma, sampler, driver = _setup_vmc()
+    log = nk.logging.RuntimeLog()
+    driver.run(10, out=log, obs={"sx": sx}, async_logging=True)
+
+    ha, sx, ma, sampler, driver_sync = _setup_vmc()
+    log_sync = nk.logging.RuntimeLog()
+    driver_sync.run(10, out=log_sync, obs={"sx": sx})
+
+    for key in ["Energy", "sx"]:
+        np.testing.assert_allclose(
+            log.data[key]["Mean"], log_sync.data[key]["Mean"], rtol=1e-6
+        )
+    np.testing.assert_array_equal(log.data["Energy"].iters, np.arange(10))
+
+    # the loggers only receive data copied to the host
+    received = []
+
+    def recording_logger(step, log_data, state):
+        received.append((step, log_data, state))
+
+    recording_logger.flush = lambda state: None
+    ha, sx, ma, sampler, driver_rec = _setup_vmc()
+    driver_rec.run(3, out=recording_logger, async_logging=True)
+    assert [step for step, _, _ in received] == [0, 1, 2]
+    for _, log_data, state in received:
+        assert not isinstance(state, nk.vqs.VariationalState)
+        for x in jax.tree_util.tree_leaves((log_data, state.variables)):
+            assert not isinstance(x, jax.Array)
+        assert state.parameters is state.variables["params"]
+
+    # errors in the loggers are raised in the main thread
+    def failing_logger(step, log_data, state):
+        raise RuntimeError("logger failed")
+
+    failing_logger.flush = lambda state: None
+    with raises(RuntimeError, match="logger failed"):
+        driver.run(3, out=failing_logger, async_logging=True)
+
+    # errors in the loop are not replaced by the errors of the loggers
+    def failing_callback(step, log_data, driver):
+        if step > 0:
+            raise ValueError("callback failed")
+        return True
+
+    with raises(ValueError, match="callback failed"):
+        driver.run(3, out=failing_logger, callback=failing_callback, async_logging=True)
+
+
 def _energy(par, vstate, H):
     vstate.parameters = par
     psi = vstate.to_array()
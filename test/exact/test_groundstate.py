@@ -95,3 +95,108 @@ def test_ed_restricted():
     # state in the constrained Hilbert space
     idx_nonzero = np.abs(v2[:, 0]) > 1e-4
     assert overlap(v1[:, 0], v2[:, 0][idx_nonzero]) == approx(1.0)
+
+
+@pytest.mark.parametrize(
+    "ha", [pytest.param(op, id=name) for name, op in operators.items()]
+)
+@pytest.mark.parametrize("chunk_size", [7, 256, 1000])
+def test_ed_chunked(ha, chunk_size):
+    w, v = nk.exact.lanczos_ed(ha, k=3, compute_eigenvectors=True)
+    w_chunk, v_chunk = nk.exact.lanczos_ed(
+        ha, k=3, compute_eigenvectors=True, chunk_size=chunk_size
+    )
+    assert w_chunk == approx(w, rel=1e-12, abs=1e-12)
+    # the matrix-vector product agrees with the sparse matrix
+    A = nk.exact._streaming_linear_operator(ha, chunk_size)
+    np.testing.assert_allclose(A @ v_chunk, ha.to_sparse() @ v_chunk, atol=1e-12)
+
+
+def test_ed_chunked_restricted():
+    g = nk.graph.Hypercube(length=8, n_dim=1, pbc=True)
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes, total_sz=0)
+    ha = nk.operator.Heisenberg(hi, graph=g)
+
+    w = nk.exact.lanczos_ed(ha, k=2)
+    for op in [ha, ha.to_jax_operator()]:
+        w_chunk = nk.exact.lanczos_ed(op, k=2, chunk_size=16)
+        assert w_chunk == approx(w, rel=1e-12, abs=1e-12)
+
+
+@pytest.mark.parametrize(
+    "ha", [pytest.param(op, id=name) for name, op in operators.items()]
+)
+def test_ed_symmetry_sectors(ha):
+    group = g.translation_group()
+    w_full = nk.exact.full_ed(ha)
+
+    # the union of the spectra of all momentum sectors is the full spectrum
+    w_sectors = []
+    for chi in group.character_table():
+        index = nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+            hi, group, chi
+        )
+        H = np.asarray(ha.to_sparse(symmetry=index).todense())
+        np.testing.assert_allclose(H, H.conj().T, atol=1e-12)
+        w_sectors.append(np.linalg.eigvalsh(H))
+    w_sectors = np.sort(np.concatenate(w_sectors))
+    assert w_sectors.shape == (hi.n_states,)
+    np.testing.assert_allclose(w_sectors, w_full, atol=1e-10)
+
+
+def test_ed_symmetry_eigenvectors():
+    ha = operators["Ising 1D"]
+    index = nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+        hi, g.translation_group()
+    )
+    w, v = nk.exact.lanczos_ed(ha, k=2, compute_eigenvectors=True, symmetry=index)
+    w_full = nk.exact.lanczos_ed(ha, k=1)
+    assert w[0] == approx(w_full[0], rel=1e-12)
+
+    psi = index.to_full_space(v)
+    assert psi.shape == (hi.n_states, 2)
+    np.testing.assert_allclose(psi.conj().T @ psi, np.eye(2), atol=1e-10)
+    np.testing.assert_allclose(ha.to_sparse() @ psi, psi * w, atol=1e-10)
+
+    w_free = nk.exact.lanczos_ed(ha, k=2, symmetry=index, matrix_free=True)
+    assert w_free == approx(w, rel=1e-12, abs=1e-12)
+
+
+@pytest.mark.parametrize(
+    "ha", [pytest.param(op, id=name) for name, op in operators.items()]
+)
+def test_ed_symmetry_chunked(ha):
+    group = g.translation_group()
+    for chi in group.character_table()[:2]:
+        index = nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+            hi, group, chi
+        )
+        w = nk.exact.lanczos_ed(ha, k=2, symmetry=index)
+        w_chunk = nk.exact.lanczos_ed(ha, k=2, symmetry=index, chunk_size=7)
+        assert w_chunk == approx(w, rel=1e-12, abs=1e-12)
+
+        # the rows streamed from the index agree with the sparse matrix
+        v = np.random.default_rng(0).normal(size=(index.n_states, 2))
+        A = nk.exact._streaming_linear_operator(ha, 7, index)
+        H = ha.to_sparse(symmetry=index)
+        np.testing.assert_allclose(A @ v, H @ v, atol=1e-12)
+
+
+def test_ed_lobpcg():
+    ha = operators["Ising 1D"]
+    w, v = nk.exact.lanczos_ed(ha, k=3, compute_eigenvectors=True)
+    w_lobpcg, v_lobpcg = nk.exact.lanczos_ed(
+        ha,
+        k=3,
+        compute_eigenvectors=True,
+        solver="lobpcg",
+        chunk_size=64,
+        scipy_args={"tol": 1e-10, "maxiter": 500},
+    )
+    assert w_lobpcg == approx(w, rel=1e-8)
+    np.testing.assert_allclose(
+        np.abs(np.sum(v.conj() * v_lobpcg, axis=0)), 1, atol=1e-6
+    )
+
+    with pytest.raises(ValueError):
+        nk.exact.lanczos_ed(ha, solver="lapack")
@@ -430,6 +430,64 @@ def test_hilbert_indexing_jax_array(hi: DiscreteHilbert):
     np.testing.assert_allclose(i_np, i_jnp)
 
 
+@pytest.mark.parametrize(
+    "hi",
+    [
+        pytest.param(nk.hilbert.Spin(0.5, 6), id="uniform"),
+        pytest.param(nk.hilbert.Spin(0.5, 6, total_sz=0), id="constrained"),
+    ],
+)
+def test_symmetry_reduced_index(hi):
+    from netket.hilbert.index import symmetric
+
+    g = nk.graph.Chain(6)
+    group = g.translation_group()
+    perms = np.asarray(group.to_array())
+
+    n_states = 0
+    for chi in group.character_table():
+        index = nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(hi, group, chi)
+        n_states += index.n_states
+
+        # representatives are mapped to themselves
+        x = index.all_states()
+        np.testing.assert_array_equal(
+            index.states_to_numbers(x), np.arange(index.n_states)
+        )
+        # all elements of an orbit are mapped to the same representative,
+        # with the phase of the group element bringing them back to it
+        numbers, phases, valid = index.canonicalize(np.asarray(x)[:, perms])
+        assert np.all(valid)
+        np.testing.assert_array_equal(
+            numbers, np.broadcast_to(np.arange(index.n_states)[:, None], numbers.shape)
+        )
+        np.testing.assert_allclose(
+            phases, np.broadcast_to(chi.conj(), phases.shape), atol=1e-12
+        )
+
+    # the sectors of all irreps span the full space
+    assert n_states == hi.n_states
+
+    # the numbers in the full space, which are 64-bit integers for the uniform
+    # space, match those of the Hilbert space
+    x = hi.all_states()
+    np.testing.assert_array_equal(
+        symmetric._full_states_to_numbers(hi, x), hi.states_to_numbers(x)
+    )
+    np.testing.assert_array_equal(
+        symmetric._full_numbers_to_states(hi, jnp.arange(hi.n_states)), x
+    )
+
+    with pytest.raises(ValueError, match="one-dimensional"):
+        nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+            hi, group, 2 * np.ones(len(group))
+        )
+    with pytest.raises(ValueError, match="sites"):
+        nk.hilbert.index.SymmetryReducedHilbertIndex.from_group(
+            nk.hilbert.Spin(0.5, 4), group
+        )
+
+
 @partial(jax.jit, static_argnums=0)
 def _states_to_local_indices_jit(hilb, x):
     return hilb.states_to_local_indices(x)
@@ -854,3 +912,46 @@ def test_hilbert_dtype_int8():
     assert hi.all_states().dtype == np.int8
     hi = nk.hilbert.SpinOrbitalFermions(4, s=1 / 2, n_fermions_per_spin=(2, 2))
     assert hi.all_states().dtype == np.int8
+
+
+@pytest.mark.parametrize(
+    "hi",
+    [
+        pytest.param(Spin(0.5, 70), id="Spin(0.5,70)"),
+        pytest.param(Qubit(5), id="Qubit(5)"),
+        pytest.param(nk.hilbert.SpinOrbitalFermions(6, n_fermions=3), id="Fermions"),
+    ],
+)
+def test_packed_states(hi):
+    assert hi.supports_packed_states
+    rng = nk.jax.PRNGSeq(1)
+    x = hi.random_state(rng.next(), 20)
+
+    packed = hi.states_to_packed(x)
+    assert packed.shape == (20, -(-hi.size // 64))
+    np.testing.assert_array_equal(hi.packed_to_states(packed, dtype=x.dtype), x)
+
+    ids = jax.random.randint(rng.next(), (20,), 0, hi.size)
+    new_packed, old_vals = nk.hilbert.random.flip_state_packed(
+        hi, rng.next(), packed, ids
+    )
+    new_states, _ = nk.hilbert.random.flip_state(hi, rng.next(), x, ids)
+    np.testing.assert_array_equal(hi.packed_to_states(new_packed), new_states)
+    np.testing.assert_array_equal(
+        old_vals, hi.states_to_local_indices(x)[np.arange(20), ids]
+    )
+
+    if hi.is_indexable:
+        np.testing.assert_array_equal(
+            hi.packed_states_to_numbers(packed), hi.states_to_numbers(x)
+        )
+        np.testing.assert_array_equal(
+            jax.jit(hi.packed_states_to_numbers)(packed), hi.states_to_numbers(x)
+        )
+
+
+def test_packed_states_unsupported():
+    hi = Fock(3, N=4)
+    assert not hi.supports_packed_states
+    with pytest.raises(TypeError, match="bit-packed"):
+        hi.states_to_packed(hi.all_states())
@@ -0,0 +1,54 @@
+# Copyright 2025 The NetKet Authors - All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+import numpy as np
+import jax
+import jax.numpy as jnp
+
+from netket.jax import pack_bits, unpack_bits
+from netket.jax._bitpacking import bit_mask, bits_before_mask, parity
+
+
+@pytest.mark.parametrize("n_bits", [1, 7, 64, 65, 130])
+def test_pack_unpack(n_bits):
+    bits = jax.random.randint(jax.random.PRNGKey(0), (3, 5, n_bits), 0, 2)
+    packed = pack_bits(bits)
+    assert packed.dtype == jnp.uint64
+    assert packed.shape == (3, 5, -(-n_bits // 64))
+    np.testing.assert_array_equal(unpack_bits(packed, n_bits), bits)
+
+    # popcount of the packed state is the number of bits set
+    np.testing.assert_array_equal(parity(packed), bits.sum(axis=-1) % 2)
+
+
+def test_pack_ordering():
+    # most significant bit first, as in the indexing of hilbert spaces
+    bits = jnp.array([1, 0, 1, 1])
+    assert int(pack_bits(bits)[0] >> 60) == 0b1011
+
+
+@pytest.mark.parametrize("n_bits", [5, 64, 100])
+def test_masks(n_bits):
+    for i in [0, 1, n_bits // 2, n_bits - 1]:
+        expected = np.zeros(n_bits, dtype=np.int8)
+        expected[i] = 1
+        np.testing.assert_array_equal(
+            unpack_bits(bit_mask(i, n_bits), n_bits), expected
+        )
+        expected = (np.arange(n_bits) < i).astype(np.int8)
+        np.testing.assert_array_equal(
+            unpack_bits(bits_before_mask(i, n_bits), n_bits), expected
+        )
@@ -14,7 +14,11 @@
 
 import netket as nk
 import pytest
+import numpy as np
 import jax.numpy as jnp
+from jax.nn.initializers import normal
+
+from netket.vqs.mc import kernels
 
 
 @pytest.mark.parametrize("dtype", [jnp.float64, jnp.complex128])
@@ -55,3 +59,56 @@ def test_mps_open(dtype):
     driver = nk.VMC(ha, op, variational_state=vs)
 
     driver.run(1)
+
+
+@pytest.mark.parametrize("pbc", [False, True])
+@pytest.mark.parametrize("chunk_size", [None, 32])
+@pytest.mark.parametrize(
+    "model_type",
+    [nk.models.tensor_networks.MPSOpen, nk.models.tensor_networks.MPSPeriodic],
+)
+def test_mps_local_value_kernel(model_type, chunk_size, pbc):
+    # the bond between the first and last site is contracted across the boundary
+    # of periodic MPS, while open MPS contract all the amplitudes for it
+    L = 6
+    g = nk.graph.Hypercube(length=L, n_dim=1, pbc=pbc)
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes)
+
+    ma = model_type(
+        hilbert=hi, bond_dim=3, param_dtype=complex, kernel_init=normal(0.2)
+    )
+    sa = nk.sampler.MetropolisLocal(hilbert=hi, n_chains=16)
+    vs = nk.vqs.MCState(sa, ma, n_samples=256, chunk_size=chunk_size)
+
+    for ha in [
+        nk.operator.IsingJax(hi, graph=g, h=0.5),
+        nk.operator.Heisenberg(hi, graph=g).to_jax_operator(),
+    ]:
+        windowed = not pbc or model_type is nk.models.tensor_networks.MPSPeriodic
+        kernel = nk.vqs.mc.get_local_kernel(vs, ha)
+        kernel_func = getattr(kernel, "func", None)
+        assert (kernel_func is kernels.local_value_kernel_jax_mps) == windowed
+
+        oloc = vs.local_estimators(ha)
+        oloc_ref = kernels.local_value_kernel_jax(
+            vs._apply_fun, vs.variables, vs.samples.reshape(-1, hi.size), ha
+        )
+        np.testing.assert_allclose(oloc.reshape(-1), oloc_ref, rtol=1e-10)
+
+        O_stat, _ = vs.expect_and_grad(ha)
+        O_stat_ref = nk.stats.statistics(oloc_ref.reshape(oloc.shape))
+        np.testing.assert_allclose(O_stat.mean, O_stat_ref.mean, rtol=1e-10)
+
+
+def test_mps_local_value_window():
+    hi = nk.hilbert.Spin(s=0.5, N=8)
+    mps_open = nk.models.tensor_networks.MPSOpen(hilbert=hi, bond_dim=2)
+    mps_periodic = nk.models.tensor_networks.MPSPeriodic(hilbert=hi, bond_dim=2)
+    ring = nk.operator.Heisenberg(hi, graph=nk.graph.Chain(8)).to_jax_operator()
+    long_range = nk.operator.PauliStringsJax(hi, ["XIIIXIII", "ZZIIIIII"])
+
+    assert kernels.mps_local_value_window(mps_open, ring) is None
+    assert kernels.mps_local_value_window(mps_periodic, ring) == 2
+    assert kernels.mps_local_value_window(mps_open, long_range) == 5
+    assert kernels.mps_local_value_window(mps_periodic, long_range) is None
+    assert kernels.mps_local_value_window(mps_periodic, long_range + ring) is None
@@ -18,6 +18,7 @@ import numpy as np
 import jax
 import jax.numpy as jnp
 from functools import partial
+import itertools
 
 import pytest
 
@@ -139,3 +140,85 @@ def test_Slater2nd_error():
         hi = nk.hilbert.SpinOrbitalFermions(3, s=0.5, n_fermions_per_spin=(2, 2))
         ma = nkx.models.Slater2nd(hi, restricted=True)
         ma.init(jax.random.PRNGKey(1), jnp.ones((4,)))
+
+
+slater_variants = [
+    pytest.param(dict(restricted=True), id="restricted"),
+    pytest.param(dict(restricted=False), id="unrestricted"),
+    pytest.param(dict(generalized=True), id="generalized"),
+]
+slater_classes = [
+    pytest.param(nk.models.Slater2nd, id="Slater2nd"),
+    pytest.param(
+        partial(nk.models.MultiSlater2nd, n_determinants=3), id="MultiSlater2nd"
+    ),
+]
+
+
+def _molecular_hamiltonian(hi, seed=0):
+    # random hamiltonian with single and double excitations
+    rng = np.random.default_rng(seed)
+    c = partial(nk.operator.fermion.destroy, hi)
+    cd = partial(nk.operator.fermion.create, hi)
+    n_orbitals = hi.n_orbitals
+
+    ha = 0.0
+    for sz in (-1, 1):
+        for i in range(n_orbitals):
+            for j in range(n_orbitals):
+                ha += float(rng.normal()) * cd(i, sz) @ c(j, sz)
+    for i, j, k, m in itertools.product(range(n_orbitals), repeat=4):
+        ha += float(rng.normal()) * cd(i, 1) @ cd(j, -1) @ c(k, -1) @ c(m, 1)
+    return ha
+
+
+@pytest.mark.parametrize("slater_class", slater_classes)
+@pytest.mark.parametrize("variant", slater_variants)
+def test_Slater2nd_generalized_orbitals(slater_class, variant):
+    hi = nk.hilbert.SpinOrbitalFermions(4, s=0.5, n_fermions_per_spin=(2, 2))
+    ma = slater_class(hi, **variant)
+    pars = ma.init(jax.random.PRNGKey(1), hi.all_states())
+
+    M = ma.apply(pars, method=ma.generalized_orbitals)
+    assert M.shape[-2:] == (hi.size, hi.n_fermions)
+    M = M.reshape((-1, hi.size, hi.n_fermions))
+
+    x = hi.all_states()
+    dets = jax.vmap(lambda x: jnp.linalg.det(M[:, x.nonzero(size=4)[0]]))(x)
+    np.testing.assert_allclose(
+        np.exp(ma.apply(pars, x)), dets.sum(axis=-1), rtol=1e-8, atol=1e-12
+    )
+
+
+@pytest.mark.parametrize("slater_class", slater_classes)
+@pytest.mark.parametrize("variant", slater_variants)
+@pytest.mark.parametrize("jax_operator", [False, True])
+@pytest.mark.parametrize("chunk_size", [None, 64])
+def test_Slater2nd_local_value_kernel(slater_class, variant, jax_operator, chunk_size):
+    from netket.vqs.mc import kernels
+
+    hi = nk.hilbert.SpinOrbitalFermions(4, s=0.5, n_fermions_per_spin=(2, 2))
+    ma = slater_class(hi, **variant)
+    ha = _molecular_hamiltonian(hi)
+    if jax_operator:
+        ha = ha.to_jax_operator()
+
+    sa = nk.sampler.MetropolisFermionHop(hi, graph=nk.graph.Chain(4), n_chains=16)
+    vs = nk.vqs.MCState(sa, ma, n_samples=128, chunk_size=chunk_size, seed=0)
+
+    σ = vs.samples.reshape(-1, hi.size)
+    args = ha.get_conn_padded(σ)
+    oloc_ref = kernels.local_value_kernel(vs._apply_fun, vs.variables, σ, args)
+
+    oloc = vs.local_estimators(ha)
+    np.testing.assert_allclose(oloc.reshape(-1), oloc_ref, rtol=1e-8)
+
+    O_stat = vs.expect(ha)
+    O_stat_ref = nk.stats.statistics(oloc_ref.reshape(oloc.shape))
+    np.testing.assert_allclose(O_stat.mean, O_stat_ref.mean, rtol=1e-8)
+
+    # with too few excitations allowed, all local values are contracted
+    oloc_fallback = kernels.local_value_kernel_slater(
+        ma, vs._apply_fun, vs.variables, σ, args, max_excitations=1
+    )
+    np.testing.assert_allclose(oloc_fallback, oloc_ref, rtol=1e-8)
@@ -1009,3 +1009,54 @@ def test_fermion_ordering():
     np.testing.assert_allclose(op1_ordered.to_dense(), op1.to_dense())
     np.testing.assert_allclose(op1_ordered.to_dense(), op2.to_dense())
     _dict_compare(op1_ordered.operators, op2.operators, 1e-8)
+
+
+@pytest.mark.parametrize("n_orbitals", [4, 70])
+def test_fermion_packed(n_orbitals):
+    hi = nk.hilbert.SpinOrbitalFermions(n_orbitals, n_fermions=n_orbitals // 2)
+    terms, weights = [], []
+    for i in range(n_orbitals):
+        j = (i + 3) % n_orbitals
+        terms += [f"{i}^ {j}", f"{j}^ {i}", f"{i}^ {i} {j}^ {j}"]
+        weights += [-1.0, -1.0, 0.5]
+    terms.append("0^ 1^ 3 2")
+    weights.append(0.25)
+    op = nk.operator.FermionOperator2ndJax(hi, terms, weights, constant=0.1)
+    x = hi.random_state(jax.random.PRNGKey(0), 8)
+
+    xp, mels = op.get_conn_padded(x)
+    xp_packed, mels_packed = op.get_conn_padded_packed(hi.states_to_packed(x))
+    np.testing.assert_allclose(mels_packed, mels)
+    np.testing.assert_array_equal(hi.packed_to_states(xp_packed, dtype=x.dtype), xp)
+
+
+def test_fermion_operator_sample_conn():
+    hi = nk.hilbert.SpinOrbitalFermions(4, n_fermions=2)
+    edges = [(0, 1), (1, 2), (2, 3)]
+    terms = [((i, 1), (j, 0)) for i, j in edges] + [((j, 1), (i, 0)) for i, j in edges]
+    ha = nk.operator.FermionOperator2ndJax(hi, terms, [1.0] * len(terms))
+    x = hi.random_state(jax.random.PRNGKey(0), 128)
+
+    # the adjoint of every term is a term, so a single term is sampled
+    assert ha._offdiag_terms_closed_under_adjoint
+    xp, log_prob_corr = ha.sample_conn(jax.random.PRNGKey(1), x)
+    np.testing.assert_array_equal(log_prob_corr, 0)
+    conn, mels = ha.get_conn_padded(x)
+    is_conn = np.all(conn == xp[:, None], axis=-1) & (np.abs(mels) > 0)
+    is_same = np.all(xp == x, axis=-1)
+    assert np.all(is_conn.any(axis=-1) | is_same)
+    assert not np.all(is_same)
+
+    # the adjoints are recognized up to normal ordering
+    terms_reordered = terms[:3] + [((i, 0), (j, 1)) for i, j in edges]
+    ha_reordered = nk.operator.FermionOperator2ndJax(
+        hi, terms_reordered, [1.0] * 3 + [-1.0] * 3
+    )
+    assert ha_reordered._offdiag_terms_closed_under_adjoint
+
+    # otherwise, all the connected elements are computed
+    ha2 = nk.operator.FermionOperator2ndJax(hi, terms[:3], [1.0] * 3)
+    assert not ha2._offdiag_terms_closed_under_adjoint
+    with pytest.warns(UserWarning, match="adjoint"):
+        xp, log_prob_corr = ha2.sample_conn(jax.random.PRNGKey(1), x)
+    assert xp.shape == x.shape
@@ -647,3 +647,57 @@ def test_pauli_strings_conversion_no_warn():
         TypeError, match=r".* hilbert spaces with local dimension != 2.*"
     ):
         nk.operator.spin.sigmax(nk.hilbert.Spin(1.0, 3), 0).to_pauli_strings()
+
+
+def test_local_operator_disk_cache(tmp_path, monkeypatch):
+    from netket.operator._local_operator import cache
+
+    monkeypatch.setattr(cache, "_memory_cache", cache.OrderedDict())
+    nk.config.netket_local_operator_cache_dir = str(tmp_path)
+    try:
+        hi = nk.hilbert.Spin(0.5, 4)
+        op = sum(sigmax(hi, i) @ sigmaz(hi, (i + 1) % 4) for i in range(4))
+        x = np.asarray(hi.all_states())
+        xp, mels = op.get_conn_padded(x)
+        assert len(list(tmp_path.glob("local_operator_*.npz"))) == 1
+
+        # the same operator rebuilt from scratch in a new process hits the disk cache
+        cache._memory_cache.clear()
+        op2 = sum(sigmax(hi, i) @ sigmaz(hi, (i + 1) % 4) for i in range(4))
+        xp2, mels2 = op2.get_conn_padded(x)
+        np.testing.assert_array_equal(xp, xp2)
+        np.testing.assert_array_equal(mels, mels2)
+        assert len(list(tmp_path.glob("local_operator_*.npz"))) == 1
+
+        # a different operator gets a different entry
+        op3 = op2 + sigmaz(hi, 0)
+        np.testing.assert_allclose(
+            op3.to_dense(), op2.to_dense() + sigmaz(hi, 0).to_dense(), atol=1e-14
+        )
+        assert len(list(tmp_path.glob("local_operator_*.npz"))) == 3
+    finally:
+        nk.config.netket_local_operator_cache_dir = ""
+
+
+@pytest.mark.parametrize("pad", [False, True])
+@pytest.mark.parametrize(
+    "op",
+    [pytest.param(op, id=name) for name, op in herm_operators.items()],
+)
+def test_get_conn_flattened_parallel(op, pad):
+    # the multithreaded kernel must give exactly the same output
+    x = np.asarray(op.hilbert.random_state(jax.random.PRNGKey(0), 64))
+
+    sections = np.empty(x.shape[0], dtype=np.int32)
+    xp, mels = op.get_conn_flattened(x, sections, pad=pad)
+
+    nk.config.netket_numba_num_threads = 2
+    try:
+        sections_p = np.empty(x.shape[0], dtype=np.int32)
+        xp_p, mels_p = op.get_conn_flattened(x, sections_p, pad=pad)
+    finally:
+        nk.config.netket_numba_num_threads = 1
+
+    np.testing.assert_array_equal(sections, sections_p)
+    np.testing.assert_array_equal(xp, xp_p)
+    np.testing.assert_array_equal(mels, mels_p)
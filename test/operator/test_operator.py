@@ -622,3 +622,34 @@ def test_operator_jax_n_conn(op):
     assert np.less_equal(n_conn_j, n_conn).all()
     # FIXME: uncomment once the numba implementation is fixed
     # np.testing.assert_equal(n_conn_j, n_conn)
+
+
+@pytest.mark.parametrize(
+    "op", [pytest.param(op, id=name) for name, op in op_jax_compatible.items()]
+)
+@common.skipif_sharding
+def test_operator_jax_get_conn_padded_offdiagonal(op):
+    op_jax = op.to_jax_operator()
+    hi = op.hilbert
+
+    states = hi.all_states()
+    v = np.random.default_rng(0).normal(size=hi.n_states)
+
+    mels_diag, xp, mels = jax.jit(lambda op, x: op.get_conn_padded_offdiagonal(x))(
+        op_jax, states
+    )
+    assert mels_diag.shape == states.shape[:-1]
+    assert xp.shape[:-1] == mels.shape
+
+    Ov = mels_diag * v + np.sum(mels * v[hi.states_to_numbers(xp)], axis=-1)
+    np.testing.assert_allclose(Ov, op.to_dense() @ v, atol=1e-12)
+
+    split_operators = (
+        nk.operator.IsingJax,
+        nk.operator.LocalOperatorJax,
+        nk.operator.PauliStringsJax,
+    )
+    if isinstance(op_jax, split_operators):
+        # the diagonal is not among the connected elements
+        is_diag = np.all(xp == states[:, None], axis=-1)
+        np.testing.assert_equal(np.asarray(mels)[is_diag], 0)
@@ -449,3 +449,82 @@ def test_cutoff_constrained(Op):
     xp, mels = ha.get_conn_padded(x)
     np.testing.assert_array_equal(mels, 0)
     np.testing.assert_array_equal(xp, x[None])
+
+
+@pytest.mark.parametrize("mode", ["index", "mask"])
+@pytest.mark.parametrize("N", [4, 70])
+def test_pauli_packed(mode, N):
+    hi = nk.hilbert.Spin(0.5, N)
+    strings = ["X" + "I" * (N - 2) + "Z", "YZ" + "I" * (N - 2), "I" * (N - 2) + "ZZ"]
+    strings.append("I" * (N - 1) + "Y")
+    ha = nk.operator.PauliStringsJax(hi, strings, [1.0, 0.5j, -2.0, 0.3], _mode=mode)
+    x = hi.random_state(jax.random.PRNGKey(0), 16)
+
+    xp, mels = ha.get_conn_padded(x)
+    xp_packed, mels_packed = ha.get_conn_padded_packed(hi.states_to_packed(x))
+    np.testing.assert_allclose(mels_packed, mels)
+    np.testing.assert_array_equal(hi.packed_to_states(xp_packed, dtype=x.dtype), xp)
+
+    # the default implementation unpacks and packs again
+    xp_ref, mels_ref = nk.operator.DiscreteJaxOperator.get_conn_padded_packed(
+        ha, hi.states_to_packed(x)
+    )
+    np.testing.assert_array_equal(xp_packed, xp_ref)
+    np.testing.assert_allclose(mels_packed, mels_ref)
+
+
+@pytest.mark.parametrize("weighted", [False, True])
+def test_pauli_sample_conn(weighted):
+    hi = nk.hilbert.Spin(0.5, 4)
+    ha = nk.operator.PauliStringsJax(
+        hi, ["XXII", "YYII", "IZZI", "IIIX", "XIIZ"], [1.0, 1.0, -2.0, 0.3, 0.7]
+    )
+    x = hi.random_state(jax.random.PRNGKey(0), 256)
+    xp, log_prob_corr = ha.sample_conn(jax.random.PRNGKey(1), x, weighted=weighted)
+    assert xp.shape == x.shape
+    assert xp.dtype == x.dtype
+
+    # the proposed states are obtained by flipping the sites of one of the strings
+    masks = jnp.array([[1, 1, 0, 0], [0, 0, 0, 1], [1, 0, 0, 0]], dtype=bool)
+    candidates = jnp.where(masks, -x[:, None], x[:, None])
+    assert jnp.all(jnp.all(candidates == xp[:, None], axis=-1).any(axis=-1))
+
+    # log of the ratio between the off-diagonal weights (or number of non-zero
+    # off-diagonal elements) of x and xp
+    def _norm(x):
+        conn, mels = ha.get_conn_padded(x)
+        offdiag = jnp.any(conn != x[:, None], axis=-1)
+        w = jnp.abs(mels) if weighted else (jnp.abs(mels) > 0)
+        return jnp.sum(w * offdiag, axis=-1)
+
+    np.testing.assert_allclose(
+        log_prob_corr, jnp.log(_norm(x)) - jnp.log(_norm(xp)), rtol=1e-6
+    )
+    # moves with zero matrix element, such as those of XX + YY on parallel
+    # spins, are never proposed
+    conn, mels = ha.get_conn_padded(x)
+    is_conn = jnp.all(conn == xp[:, None], axis=-1) & (jnp.abs(mels) > 0)
+    assert jnp.all(is_conn.any(axis=-1))
+
+
+def test_pauli_sample_conn_uniform_single_group():
+    hi = nk.hilbert.Spin(0.5, 4)
+    # XX + YY vanishes on aligned spins, and conserves the magnetization
+    ha = nk.operator.PauliStringsJax(
+        hi, ["XXII", "YYII", "IXXI", "IYYI", "ZZII"], [1.0, 1.0, 1.0, 1.0, 0.5]
+    )
+    offdiag, weights, z_sign_indices, z_sign_indexmask = ha._groups
+    assert offdiag.shape == (2,)
+    assert weights.shape[:2] == z_sign_indices.shape[:2] == (3, 2)
+
+    x = hi.random_state(jax.random.PRNGKey(0), 512)
+    xp, log_prob_corr = ha.sample_conn(jax.random.PRNGKey(1), x)
+    np.testing.assert_array_equal(log_prob_corr, 0)
+    np.testing.assert_array_equal(xp.sum(axis=-1), x.sum(axis=-1))
+
+    # the proposed states are either x or connected with a nonzero element
+    conn, mels = ha.get_conn_padded(x)
+    is_conn = jnp.all(conn == xp[:, None], axis=-1) & (jnp.abs(mels) > 0)
+    is_same = jnp.all(xp == x, axis=-1)
+    assert jnp.all(is_conn.any(axis=-1) | is_same)
+    assert not jnp.all(is_same)
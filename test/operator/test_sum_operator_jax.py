@@ -0,0 +1,166 @@
+# Copyright 2025 The Netket Authors. - All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+import numpy as np
+import jax
+
+import netket as nk
+from netket.operator import SumOperatorJax
+
+from .. import common
+
+
+def _spin_operators():
+    hi = nk.hilbert.Spin(0.5, 4)
+    pauli = nk.operator.PauliStringsJax(hi, ["ZZII", "IZZI", "XXII"], [1.0, 0.5, -0.3])
+    local = sum(nk.operator.spin.sigmax(hi, i) for i in range(hi.size))
+    ising = nk.operator.IsingJax(hi, nk.graph.Chain(hi.size), h=0.7)
+    return pauli, ising, local.to_jax_operator()
+
+
+def _fermion_operators():
+    hi = nk.hilbert.SpinOrbitalFermions(3)
+    fermion = nk.operator.FermionOperator2ndJax(
+        hi, ("0^ 1", "1^ 0", "2^ 2"), (0.5, 0.5, 1.2)
+    )
+    pauli = nk.operator.PauliStringsJax(hi, ["XII", "ZZI"], [0.3, 0.8])
+    local = nk.operator.LocalOperator(hi, [[0.2, 1.0], [1.0, -0.4]], [2])
+    return fermion, pauli, local.to_jax_operator()
+
+
+operators_to_sum = {
+    "spin": _spin_operators(),
+    "fermions": _fermion_operators(),
+}
+
+
+@pytest.mark.parametrize(
+    "ops", [pytest.param(ops, id=name) for name, ops in operators_to_sum.items()]
+)
+@common.skipif_sharding
+def test_sum_operator_jax_dense(ops):
+    a, b, c = ops
+
+    op = a + b + c
+    assert isinstance(op, SumOperatorJax)
+    assert len(op.operators) == 3
+
+    dense = a.to_dense() + b.to_dense() + c.to_dense()
+    np.testing.assert_allclose(op.to_dense(), dense, atol=1e-12)
+    np.testing.assert_allclose((c + a + b).to_dense(), dense, atol=1e-12)
+
+    np.testing.assert_allclose(
+        (2.0 * op - b).to_dense(), 2.0 * dense - b.to_dense(), atol=1e-12
+    )
+    np.testing.assert_allclose((-op).to_dense(), -dense, atol=1e-12)
+
+    # scalars are added to the diagonal
+    eye = np.eye(dense.shape[0])
+    np.testing.assert_allclose((op + 1.5).to_dense(), dense + 1.5 * eye, atol=1e-12)
+    np.testing.assert_allclose((2 - op).to_dense(), 2 * eye - dense, atol=1e-12)
+    np.testing.assert_allclose(
+        (3.0 * (op - 0.5) + b).to_dense(),
+        3.0 * (dense - 0.5 * eye) + b.to_dense(),
+        atol=1e-12,
+    )
+
+    op_inplace = c
+    op_inplace += a
+    assert isinstance(op_inplace, SumOperatorJax)
+    np.testing.assert_allclose(
+        op_inplace.to_dense(), c.to_dense() + a.to_dense(), atol=1e-12
+    )
+
+
+@pytest.mark.parametrize(
+    "ops", [pytest.param(ops, id=name) for name, ops in operators_to_sum.items()]
+)
+@common.skipif_sharding
+def test_sum_operator_jax_merges_connected_states(ops):
+    op = SumOperatorJax(*ops, coefficients=[1.0, -0.5, 2.0])
+    hi = op.hilbert
+    states = hi.all_states()
+    v = np.random.default_rng(0).normal(size=hi.n_states)
+    dense = op.to_dense()
+
+    xp, mels = jax.jit(lambda op, x: op.get_conn_padded(x))(op, states)
+    assert xp.shape == (hi.n_states, op.max_conn_size, hi.size)
+    assert mels.shape == (hi.n_states, op.max_conn_size)
+
+    # every connected state appears only once with a non-zero matrix element
+    for xp_i, mels_i in zip(np.asarray(xp), np.asarray(mels)):
+        xp_nonzero = xp_i[mels_i != 0]
+        assert len(np.unique(xp_nonzero, axis=0)) == len(xp_nonzero)
+
+    Ov = np.sum(mels * v[hi.states_to_numbers(xp)], axis=-1)
+    np.testing.assert_allclose(Ov, dense @ v, atol=1e-12)
+
+    mels_diag, xp, mels = jax.jit(lambda op, x: op.get_conn_padded_offdiagonal(x))(
+        op, states
+    )
+    Ov = mels_diag * v + np.sum(mels * v[hi.states_to_numbers(xp)], axis=-1)
+    np.testing.assert_allclose(Ov, dense @ v, atol=1e-12)
+
+
+def test_sum_operator_jax_errors():
+    pauli, _, local = _spin_operators()
+    fermion, _, _ = _fermion_operators()
+
+    with pytest.raises(ValueError):
+        SumOperatorJax(pauli, fermion)
+    with pytest.raises(TypeError):
+        SumOperatorJax(pauli, local.to_numba_operator())
+
+
+@common.skipif_sharding
+def test_sum_operator_jax_local_kernel():
+    from netket.vqs.mc import kernels
+
+    op = SumOperatorJax(*_spin_operators(), coefficients=[1.0, -0.5, 2.0]) + 0.3
+    hi = op.hilbert
+    vs = nk.vqs.MCState(nk.sampler.ExactSampler(hi), nk.models.RBM(), n_samples=64)
+    assert nk.vqs.get_local_kernel(vs, op) is kernels.local_value_kernel_jax_nonzero
+
+    σ = vs.samples.reshape(-1, hi.size)
+    args = (vs._apply_fun, {"params": vs.parameters, **vs.model_state}, σ, op)
+    np.testing.assert_allclose(
+        kernels.local_value_kernel_jax_nonzero(*args),
+        kernels.local_value_kernel_jax(*args),
+        rtol=1e-12,
+    )
+    np.testing.assert_allclose(
+        vs.local_estimators(op).reshape(-1),
+        kernels.local_value_kernel_jax(*args),
+        rtol=1e-12,
+    )
+
+
+def test_apply_masked():
+    from netket.vqs.mc.kernels import _apply_masked
+
+    calls = []
+
+    def f(x):
+        calls.append(x.shape[0])
+        return x.sum(axis=-1) ** 2
+
+    x = jax.random.randint(jax.random.PRNGKey(0), (64, 3), 0, 2)
+    for n_selected in [0, 5, 16, 17, 64]:
+        mask = np.random.default_rng(0).permutation(np.arange(64) < n_selected)
+        y = _apply_masked(f, x, mask)
+        np.testing.assert_allclose(y[mask], f(x)[mask])
+    # one buffer size is traced for every branch
+    assert sorted(set(calls[:4])) == [8, 16, 32, 64]
@@ -201,3 +201,57 @@ def test_multiplerules_pt_mpi(model_and_weights):
         chain_length=10,
     )
     assert samples.shape == (sa.n_batches // sa.n_replicas, 10, hi.size)
+
+
+def test_feedback_optimized_betas():
+    from netket.sampler.parallel_tempering import feedback_optimized_betas
+
+    betas = jnp.linspace(1, 0.1, 8)
+
+    # a linear flow is already optimal
+    f = jnp.linspace(0, 1, 8)
+    np.testing.assert_allclose(feedback_optimized_betas(betas, f), betas, atol=1e-12)
+
+    # all the flow is lost in the first interval, where temperatures accumulate
+    f = jnp.array([0.0, 0.9, 0.92, 0.94, 0.96, 0.97, 0.99, 1.0])
+    new_betas = feedback_optimized_betas(betas, f)
+    assert new_betas[0] == 1 and new_betas[-1] == betas[-1]
+    assert jnp.all(jnp.diff(new_betas) < 0)
+    assert new_betas[1] > betas[1]
+
+    damped = feedback_optimized_betas(betas, f, rate=0.5)
+    np.testing.assert_allclose(damped, (betas + new_betas) / 2)
+
+
+@common.skipif_mpi
+def test_adaptive_betas(model_and_weights):
+    g = nk.graph.Hypercube(length=4, n_dim=1)
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes)
+
+    with pytest.raises(ValueError):
+        nk.sampler.ParallelTemperingLocal(hi, adapt_betas=True, beta_adaptation_rate=0)
+
+    sa = nk.sampler.ParallelTemperingLocal(
+        hi, n_replicas=8, adapt_betas=True, sweep_size=hi.size * 4
+    )
+    ma, w = model_and_weights(hi, sa)
+
+    sampler_state = sa.init_state(ma, w, seed=SAMPLER_SEED)
+    np.testing.assert_allclose(sampler_state.ladder, sa.sorted_betas)
+
+    samples, sampler_state = sa.sample(ma, w, state=sampler_state, chain_length=20)
+    assert samples.shape == (sa.n_batches // sa.n_replicas, 20, hi.size)
+
+    ladder = sampler_state.ladder
+    assert ladder[0] == 1 and jnp.isclose(ladder[-1], sa.sorted_betas[-1])
+    assert jnp.all(jnp.diff(ladder) < 0)
+    assert not np.allclose(ladder, sa.sorted_betas)
+
+    # every replica has a different temperature of the ladder
+    order = sampler_state.replica_order
+    np.testing.assert_array_equal(jnp.sort(order, axis=-1), jnp.arange(8)[None])
+    np.testing.assert_allclose(
+        jnp.take_along_axis(sampler_state.beta, order, axis=-1),
+        jnp.broadcast_to(ladder, order.shape),
+    )
+    np.testing.assert_array_equal(sampler_state.beta_0_index, order[:, 0])
@@ -72,6 +72,14 @@ samplers["Metropolis(Local): Spin-chunked"] = nk.sampler.MetropolisLocal(
     hi, chunk_size=8
 )
 
+samplers["Metropolis(HeatBath): Spin"] = nk.sampler.MetropolisHeatBath(hi)
+samplers["Metropolis(HeatBath): Spin 1"] = nk.sampler.MetropolisHeatBath(hi_spin1)
+samplers["Metropolis(HeatBath): Fock"] = nk.sampler.MetropolisHeatBath(hib_u)
+
+samplers["Metropolis(Local,FastUpdates): Spin"] = nk.sampler.MetropolisLocal(
+    hi, use_fast_updates=True
+)
+
 samplers["MetropolisNumpy(Local): Spin"] = nk.sampler.MetropolisLocalNumpy(hi)
 samplers["MetropolisNumpy(Local): Spin-chunked"] = nk.sampler.MetropolisLocalNumpy(
     hi, chunk_size=8
@@ -87,11 +95,18 @@ samplers["MetropolisPT(Local): Spin"] = nk.sampler.ParallelTemperingLocal(
 samplers["MetropolisPT(Local): Fock"] = nk.sampler.ParallelTemperingLocal(
     hib_u, n_replicas=4, sweep_size=hib_u.size * 4
 )
+samplers["MetropolisPT(Local,adaptive): Spin"] = nk.sampler.ParallelTemperingLocal(
+    hi, n_replicas=4, sweep_size=hi.size * 4, adapt_betas=True
+)
 
 samplers["Metropolis(Exchange): Fock-1particle"] = nk.sampler.MetropolisExchange(
     hib, graph=g
 )
 
+samplers["Metropolis(Exchange,FastUpdates): Fock-1particle"] = (
+    nk.sampler.MetropolisExchange(hib, graph=g, use_fast_updates=True)
+)
+
 if not config.netket_experimental_sharding:
     samplers["Metropolis(Hamiltonian,numba operator): Spin"] = (
         nk.sampler.MetropolisHamiltonian(
@@ -104,6 +119,16 @@ if not config.netket_experimental_sharding:
 samplers["Metropolis(ParticleExchange): SpinOrbitalFermions"] = (
     nk.sampler.MetropolisFermionHop(hi_fermion, graph=g)
 )
+ha_fermion = nk.operator.FermionOperator2ndJax(
+    hi_fermion,
+    [((i, 1), (j, 0)) for i, j in g.edges()] + [((j, 1), (i, 0)) for i, j in g.edges()],
+    [-1.0] * (2 * g.n_edges),
+)
+samplers["Metropolis(Hamiltonian, FermionOperator2ndJax): SpinOrbitalFermions"] = (
+    nk.sampler.MetropolisSampler(
+        hi_fermion, nk.sampler.rules.HamiltonianRuleJax(ha_fermion)
+    )
+)
 samplers["Metropolis(ParticleExchange,Spinful): SpinOrbitalFermions"] = (
     nk.sampler.MetropolisFermionHop(hi_fermion_spin, graph=g, spin_symmetric=True)
 )
@@ -129,6 +154,26 @@ samplers["Metropolis(Hamiltonian, jax operator): Spin"] = (
     )
 )
 
+ha_pauli = nk.operator.PauliStringsJax(
+    hi,
+    ["XIII", "IXII", "IIXI", "IIIX", "XXII", "YYII", "IXXI", "IYYI", "ZZII", "IZZI"],
+    [1.0, 0.7, 0.5, 0.3, 0.5, 0.5, 0.8, 0.8, 1.0, 1.0],
+)
+
+samplers["Metropolis(Hamiltonian, PauliStringsJax): Spin"] = (
+    nk.sampler.MetropolisSampler(hi, nk.sampler.rules.HamiltonianRuleJax(ha_pauli))
+)
+samplers["Metropolis(Hamiltonian, PauliStringsJax, weighted): Spin"] = (
+    nk.sampler.MetropolisSampler(
+        hi, nk.sampler.rules.HamiltonianRuleJax(ha_pauli, weighted=True)
+    )
+)
+samplers["Metropolis(Hamiltonian, IsingJax, weighted): Spin"] = (
+    nk.sampler.MetropolisSampler(
+        hi, nk.sampler.rules.HamiltonianRuleJax(ha_jax, weighted=True)
+    )
+)
+
 samplers["Metropolis(Custom: Sx): Spin"] = nk.sampler.MetropolisCustom(
     hi, move_operators=move_op
 )
@@ -151,10 +196,56 @@ if not config.netket_experimental_sharding:
         )
     )
 
+# MultipleTryRule sampler
+samplers["Metropolis(MultipleTry[Local]): Spin"] = nk.sampler.MetropolisSampler(
+    hi, nk.sampler.rules.MultipleTryRule(nk.sampler.rules.LocalRule(), n_tries=4)
+)
+samplers["Metropolis(MultipleTry[Local],n_tries=1): Spin"] = (
+    nk.sampler.MetropolisSampler(
+        hi, nk.sampler.rules.MultipleTryRule(nk.sampler.rules.LocalRule(), n_tries=1)
+    )
+)
+samplers["Metropolis(MultipleTry[Exchange]): Fock-1particle"] = (
+    nk.sampler.MetropolisSampler(
+        hib,
+        nk.sampler.rules.MultipleTryRule(
+            nk.sampler.rules.ExchangeRule(graph=g), n_tries=3
+        ),
+    )
+)
+samplers["Metropolis(MultipleTry[Hamiltonian, weighted]): Spin"] = (
+    nk.sampler.MetropolisSampler(
+        hi,
+        nk.sampler.rules.MultipleTryRule(
+            nk.sampler.rules.HamiltonianRuleJax(ha_pauli, weighted=True), n_tries=3
+        ),
+    )
+)
+
+samplers["PopulationAnnealing(Local): Spin"] = nk.sampler.PopulationAnnealingSampler(
+    hi, nk.sampler.rules.LocalRule(), n_temperatures=8
+)
+samplers["PopulationAnnealing(Local,betas): Spin 1"] = (
+    nk.sampler.PopulationAnnealingSampler(
+        hi_spin1,
+        nk.sampler.rules.LocalRule(),
+        betas=[0.1, 0.3, 0.6, 1.0],
+        n_sweeps_per_temperature=2,
+        ess_threshold=0.8,
+    )
+)
 
 samplers["Autoregressive: Spin 1/2"] = nk.sampler.ARDirectSampler(hi)
 samplers["Autoregressive: Spin 1"] = nk.sampler.ARDirectSampler(hi_spin1)
 samplers["Autoregressive: Fock"] = nk.sampler.ARDirectSampler(hib_u)
+if not nk.config.netket_experimental_sharding:
+    samplers["Autoregressive(unique): Spin 1/2"] = nk.sampler.ARDirectSampler(
+        hi, unique_samples=True
+    )
+
+samplers["MPSDirect: Spin 1/2"] = nk.sampler.MPSDirectSampler(hi)
+samplers["MPSDirect: Spin 1"] = nk.sampler.MPSDirectSampler(hi_spin1)
+samplers["MPSDirect: Fock"] = nk.sampler.MPSDirectSampler(hib_u)
 
 
 # Hilbert space and sampler for particles
@@ -167,6 +258,12 @@ samplers["Metropolis(AdjustedLangevin): AdjustedLangevin"] = (
         hi_particles, dt=0.1, sweep_size=hi_particles.size
     )
 )
+samplers["Metropolis(HMC): HMC"] = nk.sampler.MetropolisHMC(
+    hi_particles, step_size=0.2, n_steps=5, sweep_size=1
+)
+samplers["Metropolis(HMC): HMC chunk_size"] = nk.sampler.MetropolisHMC(
+    hi_particles, step_size=0.2, n_steps=5, sweep_size=1, chunk_size=16
+)
 samplers["Metropolis(AdjustedLangevin): AdjustedLangevin chunk_size"] = (
     nk.sampler.MetropolisAdjustedLangevin(hi_particles, dt=0.1, chunk_size=16)
 )
@@ -201,6 +298,13 @@ def model_and_weights(request):
             ma = nk.models.ARNNDense(
                 hilbert=hilb, machine_pow=sampler.machine_pow, layers=3, features=5
             )
+        elif isinstance(sampler, nk.sampler.MPSDirectSampler):
+            ma = nk.models.tensor_networks.MPSOpen(
+                hilbert=hilb,
+                bond_dim=3,
+                param_dtype=complex,
+                kernel_init=normal(stddev=0.5),
+            )
         elif isinstance(hilb, Particle):
             ma = nk.models.Gaussian()
         else:
@@ -258,6 +362,8 @@ def set_pdf_power(request):
 
         if isinstance(sampler, nk.sampler.ARDirectSampler) and request.param != 2:
             pytest.skip("ARDirectSampler only supports machine_pow = 2.")
+        if isinstance(sampler, nk.sampler.MPSDirectSampler) and request.param != 2:
+            pytest.skip("MPSDirectSampler only supports machine_pow = 2.")
 
         return sampler.replace(machine_pow=request.param)
 
@@ -519,6 +625,11 @@ def test_throwing(model_and_weights):
     with pytest.raises(ValueError):
         nk.sampler.ARDirectSampler(hi, machine_pow=1)
 
+    with pytest.raises(ValueError):
+        nk.sampler.MPSDirectSampler(hi, machine_pow=1)
+    with pytest.raises(ValueError):
+        nk.sampler.MPSDirectSampler(hib)
+
     # MetropolisLocal should not work with continuous Hilbert spaces
     with pytest.raises(TypeError):
         sampler = nk.sampler.MetropolisLocal(hi_particles)
@@ -577,9 +688,21 @@ def test_setup_throwing_multiplerules():
         nk.sampler.rules.MultipleRules(rule1, [0.5, 0.5])
 
 
+@common.skipif_distributed
+def test_setup_throwing_multipletry():
+    with pytest.raises(ValueError):
+        nk.sampler.rules.MultipleTryRule(nk.sampler.rules.LocalRule(), n_tries=0)
+    with pytest.raises(TypeError):
+        nk.sampler.rules.MultipleTryRule(2)
+
+
 @common.skipif_distributed
 def test_exact_sampler(sampler):
-    known_exact_samplers = (nk.sampler.ExactSampler, nk.sampler.ARDirectSampler)
+    known_exact_samplers = (
+        nk.sampler.ExactSampler,
+        nk.sampler.ARDirectSampler,
+        nk.sampler.MPSDirectSampler,
+    )
     if isinstance(sampler, known_exact_samplers):
         assert sampler.is_exact is True
         assert sampler.n_chains_per_rank == 1
@@ -719,3 +842,311 @@ def test_chunking_invariant(model_and_weights, sampler_type):
     )
 
     np.testing.assert_allclose(samples, samples_ch)
+
+
+@pytest.mark.parametrize(
+    "model",
+    [
+        pytest.param(nk.models.RBM(alpha=2, param_dtype=complex), id="RBM"),
+        pytest.param(
+            nk.models.RBM(alpha=1, use_visible_bias=False, param_dtype=float),
+            id="RBM-novisible",
+        ),
+        pytest.param(nk.models.Jastrow(), id="Jastrow"),
+    ],
+)
+@pytest.mark.parametrize(
+    "rule",
+    [
+        pytest.param(nk.sampler.rules.LocalRule(), id="Local"),
+        pytest.param(nk.sampler.rules.ExchangeRule(graph=g), id="Exchange"),
+    ],
+)
+@common.skipif_distributed
+def test_fast_updates(model, rule):
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes)
+    w = model.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+
+    log_val, cache = model.apply(w, hi.all_states(), method="init_fast_update")
+    np.testing.assert_allclose(log_val, model.apply(w, hi.all_states()))
+
+    sa = nk.sampler.MetropolisSampler(hi, rule, use_fast_updates=True)
+    sa_full = nk.sampler.MetropolisSampler(hi, rule)
+
+    state = sa.reset(model, w, sa.init_state(model, w, seed=SAMPLER_SEED))
+    state_full = sa_full.reset(
+        model, w, sa_full.init_state(model, w, seed=SAMPLER_SEED)
+    )
+    samples, state = sa.sample(model, w, state=state, chain_length=10)
+    samples_full, _ = sa_full.sample(model, w, state=state_full, chain_length=10)
+    np.testing.assert_allclose(samples, samples_full)
+
+    # the cached log probabilities must match a full evaluation of the model
+    np.testing.assert_allclose(
+        state.log_prob,
+        sa.machine_pow * model.apply(w, state.σ).real,
+        rtol=1e-8,
+        atol=1e-8,
+    )
+    _, cache_ref = model.apply(w, state.σ, method="init_fast_update")
+    jax.tree_util.tree_map(
+        lambda x, y: np.testing.assert_allclose(x, y, rtol=1e-8, atol=1e-8),
+        state.fast_update_cache,
+        cache_ref,
+    )
+
+
+@common.skipif_distributed
+def test_fast_updates_throwing():
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes)
+
+    # the rule does not bound the number of changed sites
+    with pytest.raises(ValueError, match="max_changed_sites"):
+        nk.sampler.MetropolisHamiltonian(hi, ha_jax, use_fast_updates=True)
+
+    # the model does not implement the protocol
+    ma = nk.models.MLP(hidden_dims=(4,))
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sa = nk.sampler.MetropolisLocal(hi, use_fast_updates=True)
+    with pytest.raises(TypeError, match="fast updates"):
+        sa.sample(ma, w, chain_length=1)
+
+    with pytest.raises(ValueError):
+        nk.sampler.ParallelTemperingLocal(hi, use_fast_updates=True)
+
+
+@common.skipif_distributed
+def test_packed_states():
+    hi = nk.hilbert.Spin(s=0.5, N=g.n_nodes)
+    ma = nk.models.RBM(alpha=1)
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+
+    sa = nk.sampler.MetropolisLocal(hi, packed_states=True)
+    sa_ref = nk.sampler.MetropolisLocal(hi)
+
+    state = sa.reset(ma, w, sa.init_state(ma, w, seed=SAMPLER_SEED))
+    state_ref = sa_ref.reset(ma, w, sa_ref.init_state(ma, w, seed=SAMPLER_SEED))
+    samples, state = sa.sample(ma, w, state=state, chain_length=10)
+    samples_ref, state_ref = sa_ref.sample(ma, w, state=state_ref, chain_length=10)
+
+    # the chains and the samples are stored packed, but follow the same path
+    assert state.σ.dtype == jnp.uint64
+    assert samples.shape == (sa.n_chains, 10, 1)
+    np.testing.assert_array_equal(hi.packed_to_states(state.σ), state_ref.σ)
+    np.testing.assert_array_equal(hi.packed_to_states(samples), samples_ref)
+
+    vs = nk.vqs.MCState(sa, ma, variables=w, n_samples=512, sampler_seed=SAMPLER_SEED)
+    vs_ref = nk.vqs.MCState(
+        sa_ref, ma, variables=w, n_samples=512, sampler_seed=SAMPLER_SEED
+    )
+    vs.sample()
+    assert vs._samples.dtype == jnp.uint64
+    np.testing.assert_array_equal(vs.samples, vs_ref.samples)
+    np.testing.assert_allclose(
+        vs.expect(ha_jax).mean, vs_ref.expect(ha_jax).mean, rtol=1e-10
+    )
+
+    with pytest.raises(ValueError, match="bit-packed"):
+        nk.sampler.MetropolisLocal(nk.hilbert.Fock(3, N=2), packed_states=True)
+    with pytest.raises(NotImplementedError):
+        nk.sampler.ParallelTemperingLocal(hi, packed_states=True)
+
+
+def test_numba_parallel_kernels():
+    from netket.sampler import metropolis_numpy
+    from netket.sampler.rules import hamiltonian, hamiltonian_numpy
+
+    rng = np.random.default_rng(0)
+    n = 37
+
+    # proposals
+    n_conn = rng.integers(1, 6, size=n)
+    sections = np.cumsum(n_conn).astype(np.int32)
+    states = rng.integers(0, 2, size=(sections[-1], 4)).astype(np.float64)
+    rand_vec = rng.uniform(size=n)
+
+    out, w = np.empty((n, 4)), np.empty(n)
+    hamiltonian_numpy._choose(states, sections, out, w, rand_vec)
+    out_p, w_p = np.empty((n, 4)), np.empty(n)
+    hamiltonian_numpy._choose_parallel(states, sections, out_p, w_p, rand_vec)
+    np.testing.assert_array_equal(out, out_p)
+    np.testing.assert_array_equal(w, w_p)
+
+    out_p, w_p = np.empty((n, 4)), np.empty(n)
+    hamiltonian._choose_parallel(states, sections, rand_vec, out_p, w_p)
+    np.testing.assert_array_equal(out, out_p)
+    np.testing.assert_array_equal(w, w_p)
+
+    # acceptance
+    σ, σ1 = rng.normal(size=(2, n, 4))
+    log_prob, log_prob_1, log_prob_corr = rng.normal(size=(3, n))
+    u = rng.uniform(size=n)
+    σ_p, log_prob_p = σ.copy(), log_prob.copy()
+    acc = metropolis_numpy.acceptance_kernel(
+        σ, σ1, log_prob, log_prob_1, log_prob_corr, 1.0, u
+    )
+    acc_p = metropolis_numpy.acceptance_kernel_parallel(
+        σ_p, σ1, log_prob_p, log_prob_1, log_prob_corr, 1.0, u
+    )
+    assert acc == acc_p
+    np.testing.assert_array_equal(σ, σ_p)
+    np.testing.assert_array_equal(log_prob, log_prob_p)
+
+
+def test_heat_bath_always_accepts():
+    hi = nk.hilbert.Fock(n_max=6, N=3)
+    ma = nk.models.RBM(alpha=1, param_dtype=complex)
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sa = nk.sampler.MetropolisHeatBath(hi, n_chains=8)
+    _, state = sa.sample(ma, w, chain_length=20)
+    np.testing.assert_allclose(state.acceptance, 1.0)
+
+    with pytest.raises(TypeError, match="constrained"):
+        sa = nk.sampler.MetropolisHeatBath(nk.hilbert.Fock(3, N=3, n_particles=2))
+        sa.sample(ma, w, chain_length=1)
+
+
+def test_hmc_step_size_adaptation():
+    hi = nk.hilbert.Particle(N=2, L=(4.0,), pbc=True)
+    ma = nk.models.Gaussian()
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sa = nk.sampler.MetropolisHMC(
+        hi, step_size=2.0, n_steps=4, target_acceptance=0.7, sweep_size=1
+    )
+    state = sa.init_state(ma, w, seed=SAMPLER_SEED)
+    state = sa.reset(ma, w, state)
+    np.testing.assert_allclose(state.rule_state.step_size, 2.0)
+
+    for _ in range(20):
+        samples, state = sa.sample(ma, w, state=state, chain_length=10)
+        assert jnp.all((samples >= 0) & (samples < 4.0))
+        state = sa.reset(ma, w, state)
+
+    assert state.rule_state.n_adapt == 20
+    # the too large initial step size is reduced
+    assert state.rule_state.step_size < 2.0
+
+
+@common.skipif_distributed
+def test_population_annealing_log_Z():
+    hi = nk.hilbert.Spin(0.5, 6)
+    ma = nk.models.RBM(alpha=1, param_dtype=float, kernel_init=normal(0.5))
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sa = nk.sampler.PopulationAnnealingSampler(
+        hi, nk.sampler.rules.LocalRule(), n_chains=1024, n_temperatures=10
+    )
+    state = sa.init_state(ma, w, seed=SAMPLER_SEED)
+    state = sa.reset(ma, w, state)
+
+    log_Z = jax.nn.logsumexp(2 * ma.apply(w, hi.all_states())) - np.log(hi.n_states)
+    np.testing.assert_allclose(state.log_Z, log_Z, atol=0.1)
+    np.testing.assert_allclose(state.free_energy, -log_Z, atol=0.1)
+    # the population is resampled at the last temperature
+    assert state.n_resamplings >= 1
+    np.testing.assert_array_equal(state.log_weights, 0.0)
+    np.testing.assert_allclose(state.effective_sample_size, sa.n_chains)
+    assert state.n_steps == 0
+
+
+@common.skipif_distributed
+def test_population_annealing_warm_start():
+    hi = nk.hilbert.Spin(0.5, 6)
+    ma = nk.models.RBM(alpha=1, param_dtype=float, kernel_init=normal(0.5))
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sa = nk.sampler.PopulationAnnealingSampler(
+        hi,
+        nk.sampler.rules.LocalRule(),
+        n_chains=256,
+        n_temperatures=10,
+        reset_chains=False,
+    )
+    state = sa.init_state(ma, w, seed=SAMPLER_SEED)
+    assert not state.is_annealed
+    state = sa.reset(ma, w, state)
+    assert state.is_annealed
+    log_Z = state.log_Z
+
+    # with the same parameters the population is only resampled and evolved
+    _, state = sa.sample(ma, w, state=state, chain_length=5)
+    state = sa.reset(ma, w, state)
+    np.testing.assert_allclose(state.log_Z, log_Z)
+    assert state.n_resamplings == 1
+    np.testing.assert_allclose(state.log_prob, 2 * ma.apply(w, state.σ), rtol=1e-6)
+
+
+@common.skipif_distributed
+@pytest.mark.parametrize("packed_states", [False, True])
+def test_population_annealing_weighted_expect(packed_states):
+    hi = nk.hilbert.Spin(0.5, 6)
+    ma = nk.models.RBM(alpha=1, param_dtype=float, kernel_init=normal(0.5))
+    sa = nk.sampler.PopulationAnnealingSampler(
+        hi,
+        nk.sampler.rules.LocalRule(),
+        n_chains=1024,
+        n_temperatures=3,
+        ess_threshold=0.0,
+        resample_final=False,
+        packed_states=packed_states,
+    )
+    vs = nk.vqs.MCState(sa, ma, n_samples=4096, n_discard_per_chain=0, seed=0)
+    op = nk.operator.spin.sigmaz(hi, 0) * nk.operator.spin.sigmaz(hi, 1)
+
+    vs.sample()
+    if packed_states:
+        assert vs._samples.dtype == jnp.uint64
+    # the weighted samples are always unpacked configurations
+    assert vs._unique_samples.shape == (vs.n_samples, hi.size)
+    assert vs._has_sample_weights
+    np.testing.assert_allclose(np.sum(vs._sample_weights), 1.0, rtol=1e-6)
+    assert vs._n_effective_samples <= vs.n_samples
+
+    psi = vs.to_array()
+    exact = np.vdot(psi, op.to_sparse() @ psi).real
+    O = vs.expect(op)
+    np.testing.assert_allclose(O.mean.real, exact, atol=5 * O.error_of_mean + 1e-2)
+
+    # the weights follow the length of the chains of the last sampling
+    vs.sample(chain_length=2)
+    assert vs._unique_samples.shape == (2 * sa.n_chains, hi.size)
+    np.testing.assert_allclose(np.sum(vs._sample_weights), 1.0, rtol=1e-6)
+    assert vs._n_effective_samples <= 2 * sa.n_chains
+
+
+@common.skipif_distributed
+def test_setup_throwing_population_annealing():
+    hi = nk.hilbert.Spin(0.5, 4)
+    rule = nk.sampler.rules.LocalRule()
+    with pytest.raises(ValueError):
+        nk.sampler.PopulationAnnealingSampler(hi, rule, betas=[0.5, 0.2, 1.0])
+    with pytest.raises(ValueError):
+        nk.sampler.PopulationAnnealingSampler(hi, rule, betas=[0.5, 0.8])
+    with pytest.raises(ValueError):
+        nk.sampler.PopulationAnnealingSampler(
+            hi, rule, betas=[0.5, 1.0], n_temperatures=2
+        )
+
+
+@common.skipif_distributed
+@pytest.mark.parametrize("symperiod", [None, 2])
+def test_mps_direct_sampler_periodic(symperiod):
+    hi = nk.hilbert.Spin(s=0.5, N=6)
+    ma = nk.models.tensor_networks.MPSPeriodic(
+        hilbert=hi,
+        bond_dim=3,
+        symperiod=symperiod,
+        param_dtype=complex,
+        kernel_init=normal(stddev=0.5),
+    )
+    w = ma.init(jax.random.PRNGKey(WEIGHT_SEED), jnp.zeros((1, hi.size)))
+    sampler = nk.sampler.MPSDirectSampler(hi)
+
+    ps = np.absolute(nk.nn.to_array(hi, ma, w, normalize=False)) ** 2
+    ps /= ps.sum()
+
+    state = sampler.init_state(ma, w, seed=SAMPLER_SEED)
+    samples, _ = sampler.sample(ma, w, state=state, chain_length=20 * hi.n_states)
+    sttn = hi.states_to_numbers(np.asarray(samples.reshape(-1, hi.size)))
+    hist = np.bincount(sttn, minlength=hi.n_states)
+
+    _, pval = chisquare(hist, f_exp=sttn.size * ps)
+    assert pval > 0.01
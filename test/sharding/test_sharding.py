@@ -55,6 +55,40 @@ def test_sampling():
     _check_correct_sharding(x)
 
 
+@pytest.mark.skipif(
+    not nk.config.netket_experimental_sharding, reason="Only run with sharding"
+)
+@pytest.mark.parametrize("use_fast_updates", [False, True])
+def test_metropolis_sweep_is_local(use_fast_updates):
+    vs, *_ = _setup(8)
+    sa = vs.sampler.replace(sweep_size=4, use_fast_updates=use_fast_updates)
+    vs.sampler = sa
+    vs.sample()
+    state = vs.sampler_state
+
+    # the sweep does not communicate among devices
+    sample_next = jax.jit(lambda p, s: sa.sample_next(vs._model, p, s))
+    hlo = sample_next.lower(vs.variables, state).compile().as_text()
+    if jax.device_count() > 1:
+        assert "all-gather" not in hlo
+        assert "all-reduce" not in hlo
+
+    new_state, σ = sample_next(vs.variables, state)
+    _check_correct_sharding(σ)
+    _check_correct_sharding(new_state.log_prob)
+    _check_correct_sharding(new_state.n_accepted_proc)
+    np.testing.assert_allclose(
+        new_state.log_prob, 2 * vs.log_value(σ).real, rtol=1e-8, atol=1e-8
+    )
+    assert new_state.n_steps == state.n_steps + 4 * sa.n_chains
+
+    # every device uses a different random key
+    n_per_device = sa.n_chains // jax.device_count()
+    σ_devices = np.asarray(σ).reshape(jax.device_count(), n_per_device, -1)
+    if jax.device_count() > 1:
+        assert not np.all(σ_devices[0] == σ_devices[1])
+
+
 @pytest.mark.skipif(
     not nk.config.netket_experimental_sharding, reason="Only run with sharding"
 )
@@ -237,3 +237,15 @@ def test_R_hat():
     # stuck -> bad  R_hat:
     x[1, 100:] = 1.0
     assert statistics(x).R_hat > 1.01
+
+
+@common.skipif_mpi
+def test_weighted_statistics_ignores_padding():
+    from netket.stats.mc_stats import _weighted_statistics
+
+    data = jnp.array([1.0, 3.0, jnp.nan, jnp.inf])
+    weights = jnp.array([0.75, 0.25, 0.0, 0.0])
+    stats = _weighted_statistics(data, weights, 4)
+    np.testing.assert_allclose(stats.mean, 1.5)
+    np.testing.assert_allclose(stats.variance, 0.75)
+    np.testing.assert_allclose(stats.error_of_mean, np.sqrt(0.75 / 4))
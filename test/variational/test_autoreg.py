@@ -16,6 +16,7 @@ import netket as nk
 import netket.experimental as nkx
 import numpy as np
 import optax
+import jax
 import pytest
 from jax import numpy as jnp
 
@@ -280,3 +281,59 @@ def test_vmc_same(partial_model_pair, hilbert, param_dtype, machine_pow, skip):
 
     # Samples from FastARNN* after training should be the same as those from ARNN*
     np.testing.assert_allclose(samples_trained2, samples_trained1)
+
+
+@pytest.mark.parametrize("partial_model_pair", partial_model_pairs)
+def test_unique_samples(partial_model_pair):
+    hilbert = nk.hilbert.Spin(s=1 / 2, N=4)
+    g = nk.graph.Chain(4)
+    H = nk.operator.Ising(hilbert, graph=g, h=1.0)
+
+    vstates = []
+    for partial_model in partial_model_pair:
+        model = partial_model(hilbert, jnp.float64, 2)
+        sampler = nk.sampler.ARDirectSampler(
+            hilbert, unique_samples=True, unique_chunk_size=4
+        )
+        vstate = nk.vqs.MCState(sampler, model, n_samples=512, seed=123)
+        samples = vstate.sample()
+        vstates.append(vstate)
+
+        state = vstate.sampler_state
+        n_unique = int(state.n_unique)
+        assert samples.shape == (sampler.n_chains, vstate.chain_length, hilbert.size)
+        assert int(state.counts.sum()) == vstate.n_samples
+        assert np.all(state.counts[n_unique:] == 0)
+        # the padding repeats the first distinct sample
+        np.testing.assert_array_equal(
+            state.unique_σ[n_unique:],
+            np.broadcast_to(state.unique_σ[0], state.unique_σ[n_unique:].shape),
+        )
+
+        # the distinct samples and their counts match the samples
+        unique, counts = np.unique(
+            samples.reshape(-1, hilbert.size), axis=0, return_counts=True
+        )
+        assert n_unique == unique.shape[0] <= hilbert.n_states
+        order = np.lexsort(np.asarray(state.unique_σ[:n_unique]).T[::-1])
+        np.testing.assert_array_equal(state.unique_σ[:n_unique][order], unique)
+        np.testing.assert_array_equal(state.counts[:n_unique][order], counts)
+
+        # expectation values and gradients match those over all the samples
+        E_unique, grad_unique = vstate.expect_and_grad(H)
+        assert vstate._unique_samples.shape[0] < vstate.n_samples
+        np.testing.assert_allclose(
+            E_unique.mean, vstate.local_estimators(H).mean(), rtol=1e-10
+        )
+        vstate.chunk_size = vstate.n_samples
+        E, grad = vstate.expect_and_grad(H)
+        np.testing.assert_allclose(E_unique.mean, E.mean, rtol=1e-10)
+        np.testing.assert_allclose(E_unique.variance, E.variance, rtol=1e-8)
+        jax.tree_util.tree_map(
+            lambda x, y: np.testing.assert_allclose(x, y, rtol=1e-8, atol=1e-12),
+            grad_unique,
+            grad,
+        )
+
+    # the cache of the fast model gives the same samples
+    np.testing.assert_array_equal(vstates[0].samples, vstates[1].samples)
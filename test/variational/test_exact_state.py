@@ -259,11 +259,9 @@ def test_chunk_size_api(vstate, _mpi_size):
     with raises(ValueError):
         vstate.chunk_size = 1.5
 
-    # does not divide hi.n_states
-    with raises(ValueError):
-        vstate.chunk_size = 3
-
-    assert vstate.chunk_size is None
+    # does not divide hi.n_states, the last chunk is padded
+    vstate.chunk_size = 3
+    assert vstate.chunk_size == 3
 
     vstate.chunk_size = vstate.hilbert.n_states // 4
     assert vstate.chunk_size == vstate.hilbert.n_states // 4
@@ -286,3 +284,92 @@ def test_qgt_chunking(vstate, qgt, n_chunks):
     jax.tree_util.tree_map(
         partial(np.testing.assert_allclose, atol=1e-13), eval_nochunk, eval_chunk
     )
+
+
+@pytest.mark.parametrize(
+    "operator",
+    [
+        pytest.param(op, id=name)
+        for name, op in [
+            *operators.items(),
+            ("operator:(Jax)", operators["operator:(Hermitian Real)"].to_jax_operator()),
+        ]
+    ],
+)
+@pytest.mark.parametrize("chunk_size", [None, 4])
+def test_distributed_expect_and_grad(operator, chunk_size):
+    ma = machines["model:(C->C)"]
+    vs = nk.vqs.FullSumState(hi, ma, seed=SEED)
+    vs_dist = nk.vqs.FullSumState(
+        hi, ma, variables=vs.variables, chunk_size=chunk_size, distributed=True
+    )
+    assert vs_dist.distributed
+
+    # the model is evaluated only on the basis states, not the connected ones
+    apply_fun = vs_dist._apply_fun
+
+    def apply_fun_check_shape(variables, x, *args, **kwargs):
+        assert x.ndim == 1 or x.shape[0] <= hi.n_states
+        return apply_fun(variables, x, *args, **kwargs)
+
+    vs_dist._apply_fun = apply_fun_check_shape
+
+    O = vs.expect(operator)
+    O_dist = vs_dist.expect(operator)
+    np.testing.assert_allclose(O_dist.mean, O.mean, atol=1e-12)
+    np.testing.assert_allclose(O_dist.variance, O.variance, atol=1e-12)
+
+    O, O_grad = vs.expect_and_grad(operator)
+    O_dist, O_grad_dist = vs_dist.expect_and_grad(operator)
+    np.testing.assert_allclose(O_dist.mean, O.mean, atol=1e-12)
+    jax.tree_util.tree_map(
+        partial(np.testing.assert_allclose, atol=1e-12), O_grad_dist, O_grad
+    )
+
+
+def test_distributed_halo_exchange():
+    from netket.vqs.full_summ import distributed
+
+    # Simulates the halo exchange among 8 blocks of basis states. The flips of
+    # the last sites connect states of the same block, while the flip of site 2
+    # connects every block to a single neighbouring block.
+    N, n_blocks = 10, 8
+    hi = nk.hilbert.Spin(0.5, N)
+    op = sum(nk.operator.spin.sigmax(hi, i) for i in (2, 6, 7, 8, 9))
+    op += sum(
+        nk.operator.spin.sigmaz(hi, i) @ nk.operator.spin.sigmaz(hi, i + 1)
+        for i in range(N - 1)
+    )
+    block_size = hi.n_states // n_blocks
+
+    xp, _ = op.get_conn_padded(hi.all_states())
+    numbers = hi.states_to_numbers(xp)
+    rng = np.random.default_rng(SEED)
+    log_psi = rng.normal(size=hi.n_states) + 1j * rng.normal(size=hi.n_states)
+
+    blocks = [slice(b * block_size, (b + 1) * block_size) for b in range(n_blocks)]
+    halos = [
+        distributed._halo_requests(numbers[s], b, block_size, n_blocks)
+        for b, s in enumerate(blocks)
+    ]
+    counts = np.max([h[3] for h in halos], axis=0)
+    halo_sizes = (block_size,) + tuple(int(c) for c in counts[1:])
+
+    # every block stores its own log-amplitudes and the remote ones it needs at
+    # the two shifts to its neighbours, not the full wavefunction
+    assert sum(halo_sizes) == 3 * block_size < hi.n_states
+
+    for b, (unique, inverse, shift, _) in enumerate(halos):
+        requests, positions = distributed._halo_plan(
+            unique, inverse, shift, halo_sizes, block_size
+        )
+        assert len(requests) == sum(halo_sizes[1:])
+
+        halo = [log_psi[blocks[b]]]
+        offset = 0
+        for k, size in enumerate(halo_sizes[1:], start=1):
+            owner = blocks[(b + k) % n_blocks]
+            halo.append(log_psi[owner][requests[offset : offset + size]])
+            offset += size
+        halo = np.concatenate(halo)
+        np.testing.assert_array_equal(halo[positions], log_psi[numbers[blocks[b]]])
@@ -207,15 +207,14 @@ def test_chunk_size_api(vstate, _mpi_size):
     with raises(ValueError):
         vstate.chunk_size = -1
 
-    vstate.n_samples = 1008
+    with raises(ValueError):
+        vstate.chunk_size = "manual"
 
-    # does not divide n_samples
-    with raises(
-        ValueError,
-    ):
-        vstate.chunk_size = 100
+    vstate.n_samples = 1008
 
-    assert vstate.chunk_size is None
+    # chunk sizes that do not divide n_samples are padded
+    vstate.chunk_size = 100
+    assert vstate.chunk_size == 100
 
     vstate.chunk_size = 126
     assert vstate.chunk_size == 126
@@ -223,17 +222,22 @@ def test_chunk_size_api(vstate, _mpi_size):
     vstate.n_samples = 1008 * 2
     assert vstate.chunk_size == 126
 
-    with raises(ValueError):
-        vstate.chunk_size = 500
+    vstate.chunk_size = 500
+    assert vstate.chunk_size == 500
 
     _ = vstate.sample()
     _ = vstate.sample(n_samples=vstate.n_samples)
-    with raises(ValueError):
-        vstate.sample(n_samples=1008 + 16)
+    _ = vstate.sample(n_samples=1008 + 16)
 
     with raises(ValueError):
         vstate.sample(n_samples=1008, chain_length=100)
 
+    vstate.chunk_size = "auto"
+    assert vstate.chunk_size_auto
+    assert vstate.chunk_size is None
+    vstate.chunk_size = None
+    assert not vstate.chunk_size_auto
+
 
 @common.skipif_mpi
 def test_constructor():
@@ -520,6 +524,250 @@ def test_expect_chunking(vstate, operator, n_chunks):
     )
 
 
+@common.skipif_mpi
+def test_expect_chunking_padded(vstate):
+    # chunk sizes that do not divide the number of samples
+    operator = operators["operator:(Hermitian Real)"]
+    vstate.n_samples = 1008
+
+    vstate.chunk_size = None
+    grad_nochunk = vstate.expect_and_grad(operator)
+    qgt_nochunk = nk.optimizer.qgt.QGTOnTheFly(vstate) @ vstate.parameters
+    vstate.chunk_size = 100
+    grad_chunk = vstate.expect_and_grad(operator)
+    qgt_chunk = nk.optimizer.qgt.QGTOnTheFly(vstate) @ vstate.parameters
+
+    jax.tree_util.tree_map(
+        partial(np.testing.assert_allclose, atol=1e-13),
+        (grad_nochunk, qgt_nochunk),
+        (grad_chunk, qgt_chunk),
+    )
+
+
+@common.skipif_mpi
+def test_chunk_size_auto(vstate):
+    from netket.vqs.mc.mc_state import chunk_autotune
+
+    operator = operators["operator:(Hermitian Real)"]
+    vstate.n_samples = 512
+    vstate.samples
+    grad_nochunk = vstate.expect_and_grad(operator)
+
+    memory = chunk_autotune.compiled_memory(lambda: vstate.expect_and_grad(operator))
+    if memory is None:
+        pytest.skip("The backend does not provide a memory analysis.")
+
+    # a budget large enough does not chunk
+    vstate.chunk_size = "auto"
+    vstate.chunk_memory_budget = 2 * memory
+    vstate.expect_and_grad(operator)
+    assert vstate.chunk_size is None
+
+    vstate.chunk_memory_budget = memory // 2
+    grad_chunk = vstate.expect_and_grad(operator)
+    assert vstate.chunk_size_auto
+    assert vstate.chunk_size is not None
+    assert vstate.chunk_size < vstate.n_samples_per_rank
+
+    jax.tree_util.tree_map(
+        partial(np.testing.assert_allclose, atol=1e-13), grad_nochunk, grad_chunk
+    )
+
+
+@common.skipif_mpi
+def test_chunk_size_auto_timing(vstate):
+    from netket.vqs.mc.mc_state import chunk_autotune
+
+    operator = operators["operator:(Hermitian Real)"]
+    vstate.n_samples = 512
+    vstate.samples
+    grad_nochunk = vstate.expect_and_grad(operator)
+
+    vstate.chunk_size = "auto"
+    vstate.chunk_timing_probes = 2
+    grad_chunk = vstate.expect_and_grad(operator)
+    # largest allowed, and two smaller chunk sizes
+    n = vstate.n_samples_per_rank
+    if chunk_autotune.default_memory_budget() is None:
+        assert vstate.chunk_size in (None, n // 2, n // 4)
+
+    jax.tree_util.tree_map(
+        partial(np.testing.assert_allclose, atol=1e-13), grad_nochunk, grad_chunk
+    )
+
+    with raises(ValueError):
+        vstate.chunk_timing_probes = -1
+
+
+def test_compiled_memory_arguments():
+    from netket.vqs.mc.mc_state.chunk_autotune import compiled_memory
+
+    x = jax.numpy.ones((1 << 20,))
+    memory = compiled_memory(lambda x: jax.numpy.sum(x**2), x)
+    if memory is None:
+        pytest.skip("The backend does not provide a memory analysis.")
+    # the size of the arguments is accounted for
+    assert memory >= x.nbytes
+
+
+def test_select_fastest_chunk_size():
+    from netket.vqs.mc.mc_state.chunk_autotune import select_fastest_chunk_size
+
+    calls = []
+
+    def time_fun(chunk_size):
+        calls.append(chunk_size)
+        return {None: 3.0, 512: 2.0, 256: 1.0, 128: 1.5}[chunk_size]
+
+    assert select_fastest_chunk_size(time_fun, None, 1000, 3) == 256
+    assert calls == [None, 512, 256, 128]
+    calls.clear()
+    assert select_fastest_chunk_size(time_fun, 256, 1000, 1) == 256
+    assert calls == [256, 128]
+    # nothing to compare with
+    assert select_fastest_chunk_size(time_fun, 1, 1000, 2) == 1
+
+
+def test_select_chunk_size():
+    from netket.vqs.mc.mc_state.chunk_autotune import select_chunk_size
+
+    calls = []
+
+    def memory_fun(chunk_size):
+        calls.append(chunk_size)
+        return 1000 + 10 * (1000 if chunk_size is None else chunk_size)
+
+    assert select_chunk_size(memory_fun, 1000, 20000) is None
+    calls.clear()
+    # 1000 + 10 * c <= 3000  ->  c <= 200
+    assert select_chunk_size(memory_fun, 1000, 3000) == 128
+    # the linear extrapolation avoids compiling all the intermediate sizes
+    assert calls == [None, 512, 128]
+
+
+def test_sampling_controller_update():
+    controller = nk.vqs.SamplingController(target_ess_fraction=0.5, smoothing=1.0)
+
+    # tau = 8 samples at sweep size 4 -> 32 steps -> sweep size 16 gives tau = 2
+    sweep_size, n_discard = controller.update(4, 5, 100, 8.0, 1.0)
+    assert sweep_size == 16
+    # 4 * 32 / 16 = 8 discarded samples
+    assert n_discard == 8
+
+    # nearly independent samples: the sweep size is decreased
+    sweep_size, n_discard = controller.update(16, 8, 100, 1.0, 1.0)
+    assert sweep_size == 8
+
+    # non equilibrated chains: the discarded samples are doubled
+    _, n_discard = controller.update(8, 8, 100, 2.0, 1.5)
+    assert n_discard == 16
+    _, n_discard = controller.update(8, 64, 100, 2.0, 1.5)
+    assert n_discard == 100
+
+    # not enough samples to estimate the autocorrelation time
+    assert controller.update(8, 3, 100, float("nan"), float("nan")) == (8, 3)
+
+    with raises(ValueError):
+        nk.vqs.SamplingController(target_ess_fraction=2)
+
+
+@common.skipif_mpi
+def test_sampling_controller():
+    ma = nk.models.RBM(alpha=1)
+
+    with raises(TypeError):
+        nk.vqs.MCState(
+            nk.sampler.ExactSampler(hi),
+            ma,
+            sampling_controller=nk.vqs.SamplingController(),
+        )
+
+    controller = nk.vqs.SamplingController(max_sweep_size=64, check_interval=1)
+    sa = nk.sampler.MetropolisLocal(hi, sweep_size=64)
+    vs = nk.vqs.MCState(
+        sa, ma, n_samples=1024, seed=SEED, sampling_controller=controller
+    )
+    for _ in range(3):
+        vs.sample()
+    assert np.isfinite(controller.tau_corr)
+    # the spins are nearly independent, so the sweep size is decreased
+    assert vs.sampler.sweep_size < 64
+    assert vs.sampler.sweep_size & (vs.sampler.sweep_size - 1) == 0
+    assert 1 <= vs.n_discard_per_chain <= vs.chain_length
+    assert vs.samples.shape == (sa.n_chains, vs.chain_length, hi.size)
+
+
+@common.skipif_mpi
+def test_sampling_controller_reuses_expect_statistics(monkeypatch):
+    def _chain_diagnostics(*args):
+        raise AssertionError("The model should not be evaluated again.")
+
+    monkeypatch.setattr(
+        "netket.vqs.mc.mc_state.state.chain_diagnostics", _chain_diagnostics
+    )
+
+    controller = nk.vqs.SamplingController(max_sweep_size=64, check_interval=2)
+    sa = nk.sampler.MetropolisLocal(hi, sweep_size=64)
+    vs = nk.vqs.MCState(
+        sa,
+        nk.models.RBM(alpha=1),
+        n_samples=1024,
+        seed=SEED,
+        sampling_controller=controller,
+    )
+    op = nk.operator.spin.sigmax(hi, 0)
+    for i in range(4):
+        vs.expect(op)
+        vs.reset()
+        vs.sample()
+        # the controller is only updated every two samplings
+        assert controller._n_samplings == i % 2
+
+    assert np.isfinite(controller.tau_corr)
+    assert vs.sampler.sweep_size < 64
+
+
+@common.skipif_sharding
+@pytest.mark.parametrize("chunk_size", [None, 100])
+def test_expect_deduplicated(vstate, chunk_size):
+    # 1000 samples from 16 states, so the local values are deduplicated
+    operator = operators["operator:(IsingJax)"]
+    vstate.chunk_size = chunk_size
+    oloc = vstate.local_estimators(operator)
+    O_stat, O_grad = vstate.expect_and_grad(operator)
+
+    vstate.deduplicate_local_values = 0.1
+    oloc_dedup = vstate.local_estimators(operator)
+    O_stat_dedup, O_grad_dedup = vstate.expect_and_grad(operator)
+
+    np.testing.assert_allclose(oloc_dedup, oloc, rtol=1e-10)
+    jax.tree_util.tree_map(
+        partial(np.testing.assert_allclose, rtol=1e-10),
+        (O_stat, O_grad),
+        (O_stat_dedup, O_grad_dedup),
+    )
+
+
+def test_deduplicate_local_values_setter():
+    vs = nk.vqs.MCState(nk.sampler.ExactSampler(hi), nk.models.RBM(), n_samples=64)
+    assert vs.deduplicate_local_values is None
+    for fraction in [0.0, 1.5, True]:
+        with pytest.raises(ValueError):
+            vs.deduplicate_local_values = fraction
+    vs.deduplicate_local_values = 1.0
+    assert vs.deduplicate_local_values == 1.0
+
+
+def test_apply_unique_fallback():
+    from netket.vqs.mc.kernels import _apply_unique
+
+    f = lambda x: x.sum(axis=-1) ** 2
+    x = jax.random.randint(jax.random.PRNGKey(0), (50, 3), 0, 2)
+    # 8 distinct rows, both with enough and too little space in the buffer
+    for max_unique in [4, 8, 20]:
+        np.testing.assert_allclose(_apply_unique(f, x, max_unique), f(x))
+
+
 def test_reproducible_copy():
     # This checks that if i duplicate a variational state and perform the same operations
     # I get exactly the same samples